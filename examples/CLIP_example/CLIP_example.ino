@@ -84,32 +84,16 @@ void setup() {
         Serial.print("pdp context read :");
         Serial.println(myME310.buffer_cstr(1));              //print second line of modem answer
 
-        Serial.print("gprs network registration status :");
-        rc = myME310.read_gprs_network_registration_status();  //issue command AT+CGREG? (read mode)
-        Serial.println(myME310.buffer_cstr(1));
+        Serial.println("Network registration");
+        rc = myME310.registration_enable_indications();   //issue commands AT+CREG=2, AT+CGREG=2, AT+CEREG=2 and read the registration state
         if(rc == ME310::RETURN_VALID)
         {
-          resp = (char*)myME310.buffer_cstr(1);
-          while(resp != NULL)
+          //wait for +CGREG or +CEREG to report the registration (home or roaming), returns as soon as it is received
+          while(myME310.wait_until_registered(30000) != ME310::RETURN_VALID)
           {
-            if((strcmp(resp, "+CGREG: 0,1") != 0) &&  (strcmp(resp, "+CGREG: 0,5") != 0))
-            {
-              delay(3000);
-              rc = myME310.read_gprs_network_registration_status();
-              if(rc !=  ME310::RETURN_VALID)
-              {
-                Serial.println("ERROR");
-                Serial.println(myME310.return_string(rc));
-                break;
-              }
-              Serial.println(myME310.buffer_cstr(1));
-              resp = (char*) myME310.buffer_cstr(1);
-            }
-            else
-            {
-              break;
-            }
+            Serial.println("Waiting for network registration");
           }
+          Serial.println("Registered");
         }
         Serial.println("Activate context");
         myME310.context_activation(cID, 1);        //issue command AT#SGACT=cid,state and wait for answer or timeout
@@ -31,7 +31,6 @@
  */
 
 #include <ME310.h>
-#include <string>
 
 /*When NMEA_DEBUG is 0 Unsolicited NMEA is disable*/
 #define NMEA_DEBUG 0
@@ -164,34 +163,24 @@ void loop() {
   //  AT$GPSACP
   /////////////////////////////////////
 
-  rc = myME310.gps_get_acquired_position();
+  ME310::gnss_fix_t fix;
+  rc = myME310.gps_get_acquired_position(fix);
 
   /*When the position is fixed, the led blinks*/
   if (rc == ME310::RETURN_VALID)
   {
     Serial.println(myME310.buffer_cstr(1));
-    char* buff = (char*)myME310.buffer_cstr(1);
-    std::string tmp_pos;
-    if(buff != NULL)
+    if(fix.valid)
     {
-      tmp_pos = buff;
-      std::size_t len_pos = tmp_pos.find(":");
-      if(len_pos != std::string::npos)
-      {
-        std::size_t len_pos2 = tmp_pos.find(",");
-        char valid_pos[64];
-        if(len_pos2 != std::string::npos)
-        {
-          int len = tmp_pos.copy(valid_pos, ((len_pos2-1)-len_pos), len_pos+1);
-          if(len > 2)
-          {
-            digitalWrite(LED_BUILTIN, HIGH);
-            delay(6000);
-            digitalWrite(LED_BUILTIN, LOW);
-            delay(1000);
-          }
-        }
-      }
+      char position[64];
+      /* latitude and longitude are in 1e-7 degrees, altitude in cm */
+      snprintf(position, sizeof(position), "lat %ld lon %ld alt %ld sat %d",
+               (long)fix.latitude, (long)fix.longitude, (long)fix.altitude, fix.satellites);
+      Serial.println(position);
+      digitalWrite(LED_BUILTIN, HIGH);
+      delay(6000);
+      digitalWrite(LED_BUILTIN, LOW);
+      delay(1000);
     }
   }
   delay(5000);
@@ -103,35 +103,17 @@ void setup() {
         rc = myME310.select_wireless_network(12);
         if (rc == ME310::RETURN_VALID)
         {
-          //issue command AT+CREG? to check the network status
+          //enable the registration unsolicited codes and wait for the network registration
           Serial.println("Network status");
-          rc = myME310.read_network_registration_status();
-          Serial.println(myME310.buffer_cstr(1));
-          if (rc == ME310::RETURN_VALID)
+          rc = myME310.registration_enable_indications();   //issue commands AT+CREG=2, AT+CGREG=2, AT+CEREG=2 and read the registration state
+          if(rc == ME310::RETURN_VALID)
           {
-            //if +CREG!=0,1 and +CREG!=0,5, wait 3 second than retry the reading
-            resp = (char*)myME310.buffer_cstr(1);
-
-            while(resp != NULL)
+            //wait for +CGREG or +CEREG to report the registration (home or roaming), returns as soon as it is received
+            while(myME310.wait_until_registered(30000) != ME310::RETURN_VALID)
             {
-                if ((strcmp(resp, "+CREG: 0,1") != 0) &&  (strcmp(resp, "+CREG: 0,5") != 0))
-                {
-                  delay(3000);
-                  rc = myME310.read_network_registration_status();
-				  if(rc != ME310::RETURN_VALID)
-				  {
-					Serial.println("ERROR");
-					Serial.println(myME310.return_string(rc));
-					break;
-				  }
-                  Serial.println(myME310.buffer_cstr(1));
-                  resp = (char*)myME310.buffer_cstr(1);
-                }
-                else
-                {
-                  break;
-                }
+              Serial.println("Waiting for network registration");
             }
+            Serial.println("Registered");
           }
         }
       }
@@ -142,34 +124,17 @@ void setup() {
       rc = myME310.select_wireless_network(12);  //issue command AT+WS46=12(2G)
       if (rc == ME310::RETURN_VALID)
       {
-        //issue command AT+CREG? to check the network status
+        //enable the registration unsolicited codes and wait for the network registration
         Serial.println("Network status");
-        rc = myME310.read_network_registration_status();
-        Serial.println(myME310.buffer_cstr(1));
-        if (rc == ME310::RETURN_VALID)
+        rc = myME310.registration_enable_indications();   //issue commands AT+CREG=2, AT+CGREG=2, AT+CEREG=2 and read the registration state
+        if(rc == ME310::RETURN_VALID)
         {
-          //if +CREG!=0,1 and +CREG!=0,5, wait 3 second than retry the reading
-          resp = (char*)myME310.buffer_cstr(1);
-          while(resp != NULL)
+          //wait for +CGREG or +CEREG to report the registration (home or roaming), returns as soon as it is received
+          while(myME310.wait_until_registered(30000) != ME310::RETURN_VALID)
           {
-            if ((strcmp(resp, "+CREG: 0,1") != 0) &&  (strcmp(resp, "+CREG: 0,5") != 0))
-            {
-              delay(3000);
-              rc = myME310.read_network_registration_status();
-              if(rc != ME310::RETURN_VALID)
-              {
-                Serial.println("ERROR");
-                Serial.println(myME310.return_string(rc));
-                break;
-              }
-              Serial.println(myME310.buffer_cstr(1));
-              resp = (char*)myME310.buffer_cstr(1);
-            }
-            else
-            {
-              break;
-            }
+            Serial.println("Waiting for network registration");
           }
+          Serial.println("Registered");
         }
       }
     }
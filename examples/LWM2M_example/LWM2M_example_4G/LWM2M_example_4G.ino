@@ -99,68 +99,34 @@ void setup() {
       {
         Serial.println("PIN inserted");
 
-        //issue command AT+CREG? to check the network status
+        //enable the registration unsolicited codes and wait for the network registration
         Serial.println("Network status");
-        rc = myME310.read_eps_network_registration_status();
-        if (rc == ME310::RETURN_VALID)
+        rc = myME310.registration_enable_indications();   //issue commands AT+CREG=2, AT+CGREG=2, AT+CEREG=2 and read the registration state
+        if(rc == ME310::RETURN_VALID)
         {
-          //if +CEREG!=0,1 and +CEREG!=0,5, wait 3 second than retry the reading
-          resp = (char*)myME310.buffer_cstr(1);
-          Serial.println(resp);
-          while(resp != NULL)
+          //wait for +CGREG or +CEREG to report the registration (home or roaming), returns as soon as it is received
+          while(myME310.wait_until_registered(30000) != ME310::RETURN_VALID)
           {
-            if ((strcmp(resp, "+CEREG: 0,1") != 0) &&  (strcmp(resp, "+CEREG: 0,5") != 0))
-            {
-              delay(3000);
-              rc = myME310.read_eps_network_registration_status();
-              if(rc != ME310::RETURN_VALID)
-              {
-                Serial.println("ERROR");
-                Serial.println(myME310.return_string(rc));
-                break;
-              }
-              Serial.println(myME310.buffer_cstr(1));
-              resp = (char*)myME310.buffer_cstr(1);
-            }
-            else
-            {
-              break;
-            }
+            Serial.println("Waiting for network registration");
           }
+          Serial.println("Registered");
         }
       }
     }
     else if (strcmp(resp, "+CPIN: READY") == 0)
     {
 
-      //issue command AT+CREG? to check the network status
+      //enable the registration unsolicited codes and wait for the network registration
       Serial.println("Network status");
-      rc = myME310.read_eps_network_registration_status();
-      if (rc == ME310::RETURN_VALID)
+      rc = myME310.registration_enable_indications();   //issue commands AT+CREG=2, AT+CGREG=2, AT+CEREG=2 and read the registration state
+      if(rc == ME310::RETURN_VALID)
       {
-        //if +CEREG!=0,1 and +CEREG!=0,5, wait 3 second than retry the reading
-        resp = (char*)myME310.buffer_cstr(1);
-        Serial.println(resp);
-        while(resp != NULL)
+        //wait for +CGREG or +CEREG to report the registration (home or roaming), returns as soon as it is received
+        while(myME310.wait_until_registered(30000) != ME310::RETURN_VALID)
         {
-          if ((strcmp(resp, "+CEREG: 0,1") != 0) &&  (strcmp(resp, "+CEREG: 0,5") != 0))
-          {
-            delay(3000);
-            rc = myME310.read_eps_network_registration_status();
-            if(rc != ME310::RETURN_VALID)
-            {
-              Serial.println("ERROR");
-              Serial.println(myME310.return_string(rc));
-              break;
-            }
-            Serial.println(myME310.buffer_cstr(1));
-            resp = (char*)myME310.buffer_cstr(1);
-          }
-          else
-          {
-            break;
-          }
+          Serial.println("Waiting for network registration");
         }
+        Serial.println("Registered");
       }
     }
   }
@@ -307,31 +307,15 @@ bool registrationStatus()
 {
   bool rc = true;
   Serial.println("GPRS network registration status");
-  myRc = myME310.read_gprs_network_registration_status();  //issue command AT+CGREG=? (read mode)
+  myRc = myME310.registration_enable_indications();   //issue commands AT+CREG=2, AT+CGREG=2, AT+CEREG=2 and read the registration state
   if(myRc == ME310::RETURN_VALID)
   {
-    char *resp = (char*) myME310.buffer_cstr(1);
-    while(resp != NULL)
+    //wait for +CGREG or +CEREG to report the registration (home or roaming), returns as soon as it is received
+    while(myME310.wait_until_registered(30000) != ME310::RETURN_VALID)
     {
-      if ((strcmp(resp, "+CGREG: 0,1") != 0) && (strcmp(resp, "+CGREG: 0,5") != 0))
-      {
-        delay(3000);
-        myRc = myME310.read_gprs_network_registration_status();
-        if(myRc != ME310::RETURN_VALID)
-        {
-          Serial.print("Read GPRS network registration status: ");
-          Serial.println(myME310.return_string(myRc));
-          rc = false;
-          break;
-        }
-        Serial.println(myME310.buffer_cstr(1));
-        resp = (char* )myME310.buffer_cstr(1);
-      }
-      else
-      {
-        break;
-      }
+      Serial.println("Waiting for network registration");
     }
+    Serial.println("Registered");
   }
   else
   {
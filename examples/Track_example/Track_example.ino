@@ -0,0 +1,152 @@
+/*Copyright (C) 2026 Telit Communications S.p.A. Italy - All Rights Reserved.*/
+/*    See LICENSE file in the project root for full license information.     */
+
+/**
+  @file
+    ME310.cpp
+    TrackEncoder.h
+
+  @brief
+    Sample test of the GNSS track compression via ME310 library
+
+  @details
+    In this example sketch, it is shown how to thin and encode GNSS fixes with the TrackEncoder class.\n
+    At startup a synthetic 1 Hz trail is encoded and the bytes per fix are printed, compared with the
+    12 bytes of a raw latitude, longitude and time record.\n
+    Then the positions read with AT$GPSACP every second are encoded, and each full frame is printed in hex:
+    it can be decoded with extras/track_decoder/track_decoder.py -x <frame>.
+	NOTE:\n
+	For the sketch to work correctly, GNSS should be tested in open sky conditions to allow a fix. The fix may take a few minutes.
+
+  @version
+    1.0.0
+
+  @note
+
+  @author
+
+  @date
+    18/10/2026
+ */
+
+#include <ME310.h>
+#include <TrackEncoder.h>
+
+#ifndef ARDUINO_TELIT_SAMD_CHARLIE
+#define ON_OFF 6 /*Select the GPIO to control ON_OFF*/
+#endif
+
+#define TOLERANCE_CM 500    /*Dead band: max distance in cm of the dropped fixes from the rebuilt track*/
+#define MAX_GAP_SEC 60      /*A point is kept at least every MAX_GAP_SEC seconds*/
+#define FRAME_SIZE 256
+
+using namespace me310;
+/*
+ * If a Telit-Board Charlie is not in use, the ME310 class needs the Uart Serial instance in the constructor, that will be used to communicate with the modem.\n
+ * Please refer to your board configuration in variant.h file.
+ * Example:
+ * Uart Serial1(&sercom4, PIN_MODULE_RX, PIN_MODULE_TX, PAD_MODULE_RX, PAD_MODULE_TX, PIN_MODULE_RTS, PIN_MODULE_CTS);
+ * ME310 myME310 (Serial1);
+ */
+ME310 myME310;
+
+ME310::return_t rc;
+uint8_t frame[FRAME_SIZE];
+TrackEncoder encoder(frame, sizeof(frame), TOLERANCE_CM, MAX_GAP_SEC);
+
+void print_frame(const uint8_t *data, size_t len)
+{
+  char hex[3];
+  for(size_t i = 0; i < len; i++)
+  {
+    snprintf(hex, sizeof(hex), "%02x", data[i]);
+    Serial.print(hex);
+  }
+  Serial.println();
+}
+
+/*Encodes a 10 minutes trail at 14 m/s, with a turn every minute and about 1 m of noise*/
+void benchmark()
+{
+  uint8_t benchFrame[FRAME_SIZE];
+  TrackEncoder bench(benchFrame, sizeof(benchFrame), TOLERANCE_CM, MAX_GAP_SEC);
+  float north = 0, east = 0, heading = 0.5;
+  uint32_t seed = 1;
+  const int fixes = 600;
+  for(int t = 0; t < fixes; t++)
+  {
+    if(t % 60 >= 50)
+    {
+      heading += 0.08;
+    }
+    north += 14 * cos(heading);
+    east += 14 * sin(heading);
+    seed = seed * 1103515245 + 12345;
+    float noise = (int)((seed >> 16) % 200 - 100) / 100.0;
+    int32_t latitude = 457135100 + (int32_t)((north + noise) * 100 / 1.113195);
+    int32_t longitude = 92403517 + (int32_t)((east - noise) * 100 / 1.113195 / 0.698);
+    if(bench.add(latitude, longitude, 1631491200UL + t) == TrackEncoder::TRACK_FULL)
+    {
+      bench.finish();
+      print_frame(bench.frame(), bench.length());
+      bench.reset();
+      bench.add(latitude, longitude, 1631491200UL + t);
+    }
+  }
+  bench.finish();
+  print_frame(bench.frame(), bench.length());
+  Serial.print("Fixes: ");
+  Serial.println(fixes);
+  Serial.print("Points kept: ");
+  Serial.println(bench.kept());
+  Serial.print("Bytes: ");
+  Serial.println(bench.bytes());
+  Serial.print("Bytes per fix x100: ");
+  Serial.println(bench.bytes() * 100 / fixes);
+  Serial.print("Raw bytes per fix: ");
+  Serial.println(12);
+}
+
+void setup() {
+  pinMode(ON_OFF, OUTPUT);
+  pinMode(LED_BUILTIN, OUTPUT);
+
+  Serial.begin(115200);
+  myME310.begin(115200);
+  delay(1000);
+  myME310.powerOn(ON_OFF);
+  delay(5000);
+  Serial.println("Telit Test GNSS track compression");
+
+  Serial.println("Benchmark");
+  benchmark();
+
+  /////////////////////////////////////
+  // Set on GNSS controller
+  // AT$GPSP=1
+  /////////////////////////////////////
+  Serial.println("Set on GNSS controller");
+  rc = myME310.gnss_controller_power_management(1);
+  Serial.println(ME310::return_string(rc));
+}
+
+void loop() {
+  delay(1000);
+  /////////////////////////////////////
+  //  Get Acquired Position
+  //  AT$GPSACP
+  /////////////////////////////////////
+  ME310::gnss_fix_t fix;
+  rc = myME310.gps_get_acquired_position(fix);
+  if(rc == ME310::RETURN_VALID && fix.valid)
+  {
+    if(encoder.add(fix) == TrackEncoder::TRACK_FULL)
+    {
+      encoder.finish();
+      Serial.print("Frame: ");
+      print_frame(encoder.frame(), encoder.length());
+      encoder.reset();
+      encoder.add(fix);
+    }
+  }
+}
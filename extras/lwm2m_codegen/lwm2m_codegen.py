@@ -0,0 +1,134 @@
+#!/usr/bin/env python3
+# Copyright (C) 2026 Telit Communications S.p.A. Italy - All Rights Reserved.
+# See LICENSE file in the project root for full license information.
+"""Generates the LWM2MDescriptor.h tables of an LWM2M object from its OMA xml definition.
+
+Usage:
+    python3 lwm2m_codegen.py object_3200.xml [-o object_3200.h] [-n namespace]
+
+The generated header declares, in namespace lwm2m_<object id> unless -n is given:
+    - Object: the LWM2MObject descriptor of the object
+    - Writer: the LWM2MObjectWriter of the object
+    - one constexpr LWM2MResource descriptor per resource, named after the resource
+      (e.g. DIGITAL_INPUT_STATE), carrying its identifier, type and multiplicity
+
+Example:
+    #include "object_3200.h"
+    LWM2M_set(myME310, lwm2m_3200::DIGITAL_INPUT_STATE, 0, true);
+    lwm2m_3200::Writer writer(0);
+    writer.add(lwm2m_3200::DIGITAL_INPUT_COUNTER, 12);
+    writer.add(lwm2m_3200::APPLICATION_TYPE, "door");
+    writer.send(myME310, 0);
+"""
+
+import argparse
+import os
+import re
+import sys
+import xml.etree.ElementTree as ET
+
+TYPES = {
+    "": "LWM2M_TYPE_NONE",
+    "integer": "LWM2M_TYPE_INTEGER",
+    "unsigned integer": "LWM2M_TYPE_INTEGER",
+    "float": "LWM2M_TYPE_FLOAT",
+    "boolean": "LWM2M_TYPE_BOOLEAN",
+    "string": "LWM2M_TYPE_STRING",
+    "corelnk": "LWM2M_TYPE_STRING",
+    "opaque": "LWM2M_TYPE_OPAQUE",
+    "time": "LWM2M_TYPE_TIME",
+    "objlnk": "LWM2M_TYPE_OBJLNK",
+}
+
+
+def identifier(name, used):
+    """Converts a resource name to a unique C++ constant name."""
+    ident = re.sub(r"[^0-9A-Za-z]+", "_", name).strip("_").upper() or "RESOURCE"
+    if ident[0].isdigit():
+        ident = "R_" + ident
+    base, n = ident, 2
+    while ident in used:
+        ident = "%s_%d" % (base, n)
+        n += 1
+    used.add(ident)
+    return ident
+
+
+def text(node, tag):
+    child = node.find(tag)
+    return (child.text or "").strip() if child is not None else ""
+
+
+def parse(path):
+    obj = ET.parse(path).getroot().find("Object")
+    if obj is None:
+        raise ValueError("%s: no Object element" % path)
+    resources = []
+    used = set(["Object", "Writer"])
+    for item in obj.find("Resources").findall("Item"):
+        kind = text(item, "Type").lower()
+        if kind not in TYPES:
+            raise ValueError("%s: resource %s has unknown type %s" % (path, item.get("ID"), kind))
+        resources.append({
+            "id": int(item.get("ID")),
+            "name": text(item, "Name"),
+            "ident": identifier(text(item, "Name"), used),
+            "type": TYPES[kind],
+            "multiple": text(item, "MultipleInstances") == "Multiple",
+            "operations": text(item, "Operations"),
+        })
+    return {
+        "id": int(text(obj, "ObjectID")),
+        "name": text(obj, "Name"),
+        "multiple": text(obj, "MultipleInstances") == "Multiple",
+        "resources": resources,
+    }
+
+
+def generate(obj, source, namespace):
+    guard = "__LWM2M_OBJECT_%d__H" % obj["id"]
+    out = []
+    out.append("/* Generated by lwm2m_codegen.py from %s, do not edit. */" % os.path.basename(source))
+    out.append("/* %d: %s */" % (obj["id"], obj["name"]))
+    out.append("#ifndef %s" % guard)
+    out.append("#define %s" % guard)
+    out.append("")
+    out.append("#include <LWM2MDescriptor.h>")
+    out.append("")
+    out.append("namespace %s" % namespace)
+    out.append("{")
+    out.append("   typedef me310::LWM2MObject<%d, %s> Object;" % (obj["id"], "true" if obj["multiple"] else "false"))
+    out.append("   typedef me310::LWM2MObjectWriter<Object> Writer;")
+    out.append("")
+    decls = ["   constexpr me310::LWM2MResource<%d, %d, me310::%s, %s> %s {};" % (
+        obj["id"], r["id"], r["type"], "true" if r["multiple"] else "false", r["ident"]) for r in obj["resources"]]
+    width = max([len(d) for d in decls] + [0])
+    for decl, r in zip(decls, obj["resources"]):
+        out.append("%s   //!< %s (%s)" % (decl.ljust(width), r["name"], r["operations"] or "-"))
+    out.append("} // end namespace")
+    out.append("")
+    out.append("#endif //%s" % guard)
+    return "\n".join(out) + "\n"
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("xml", help="OMA object definition")
+    parser.add_argument("-o", "--output", help="generated header, default object_<id>.h")
+    parser.add_argument("-n", "--namespace", help="namespace of the tables, default lwm2m_<id>")
+    args = parser.parse_args()
+
+    try:
+        obj = parse(args.xml)
+    except (ET.ParseError, ValueError, AttributeError) as error:
+        sys.stderr.write("lwm2m_codegen: %s\n" % error)
+        return 1
+    output = args.output or "object_%d.h" % obj["id"]
+    namespace = args.namespace or "lwm2m_%d" % obj["id"]
+    with open(output, "w") as f:
+        f.write(generate(obj, args.xml, namespace))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,107 @@
+#!/usr/bin/env python3
+# Copyright (C) 2026 Telit Communications S.p.A. Italy - All Rights Reserved.
+# See LICENSE file in the project root for full license information.
+"""Decodes the GNSS track frames written by the TrackEncoder class.
+
+Usage:
+    python3 track_decoder.py frame.bin [frame2.bin ...]
+    python3 track_decoder.py -x 0101050ac0...
+
+Each frame is printed as CSV lines time,latitude,longitude, with the coordinates in degrees.
+A summary with the number of points and the bytes per point is written to stderr; with -n the
+number of fixes given to the encoder is used instead, to report the bytes per fix.
+
+Frame layout (all integers are little endian base 128 varints):
+    version (1), precision p, number of points,
+    first point: zigzag latitude, zigzag longitude, time
+    other points: zigzag delta latitude, zigzag delta longitude, zigzag delta time
+Coordinates are in 10^(p-7) degrees, times in seconds; deltas wrap around 32 bits.
+"""
+
+import argparse
+import binascii
+import sys
+
+VERSION = 1
+
+
+def varint(data, pos):
+    value, shift = 0, 0
+    while True:
+        if pos >= len(data):
+            raise ValueError("truncated varint at byte %d" % pos)
+        byte = data[pos]
+        pos += 1
+        value |= (byte & 0x7F) << shift
+        shift += 7
+        if not byte & 0x80:
+            return value & 0xFFFFFFFF, pos
+
+
+def unzigzag(value):
+    return (value >> 1) ^ -(value & 1)
+
+
+def wrap(value):
+    value &= 0xFFFFFFFF
+    return value - 0x100000000 if value & 0x80000000 else value
+
+
+def decode(data):
+    """Returns the list of (time, latitude, longitude) points of a frame, coordinates in degrees."""
+    if len(data) < 3 or data[0] != VERSION:
+        raise ValueError("not a track frame")
+    unit = 10 ** (data[1] - 7)
+    count = data[2]
+    pos = 3
+    points = []
+    latitude = longitude = time = 0
+    for i in range(count):
+        a, pos = varint(data, pos)
+        b, pos = varint(data, pos)
+        c, pos = varint(data, pos)
+        if i == 0:
+            latitude, longitude, time = unzigzag(a), unzigzag(b), c
+        else:
+            latitude = wrap(latitude + unzigzag(a))
+            longitude = wrap(longitude + unzigzag(b))
+            time = (time + unzigzag(c)) & 0xFFFFFFFF
+        points.append((time, latitude * unit, longitude * unit))
+    if pos != len(data):
+        raise ValueError("%d trailing bytes" % (len(data) - pos))
+    return points
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("frames", nargs="+", help="frame files, or hex strings with -x")
+    parser.add_argument("-x", "--hex", action="store_true", help="frames given as hex strings")
+    parser.add_argument("-n", "--fixes", type=int, help="number of fixes given to the encoder")
+    args = parser.parse_args()
+
+    total_bytes = total_points = 0
+    for frame in args.frames:
+        try:
+            if args.hex:
+                data = bytearray(binascii.unhexlify(frame.strip()))
+            else:
+                with open(frame, "rb") as f:
+                    data = bytearray(f.read())
+            points = decode(data)
+        except (IOError, ValueError, TypeError, binascii.Error) as error:
+            sys.stderr.write("track_decoder: %s: %s\n" % (frame if not args.hex else "frame", error))
+            return 1
+        for time, latitude, longitude in points:
+            print("%d,%.7f,%.7f" % (time, latitude, longitude))
+        total_bytes += len(data)
+        total_points += len(points)
+
+    fixes = args.fixes or total_points
+    sys.stderr.write("%d frames, %d points, %d bytes, %.2f bytes per %s\n" % (
+        len(args.frames), total_points, total_bytes, float(total_bytes) / max(fixes, 1),
+        "fix" if args.fixes else "point"))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
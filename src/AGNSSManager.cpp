@@ -0,0 +1,266 @@
+/*Copyright (C) 2026 Telit Communications S.p.A. Italy - All Rights Reserved.*/
+/*    See LICENSE file in the project root for full license information.     */
+
+/**
+  @file
+    AGNSSManager.cpp
+
+  @brief
+    Lifecycle of the AGNSS assistance data and time to first fix per start type
+
+  @details
+    The class keeps track of the age of the assistance data downloaded through AT$AGNSS, refreshes it
+    when the PDP context is already active, and starts the GNSS controller with the fastest start type
+    allowed by the last fix and the assistance data, recording the time to first fix of each type.\n
+
+  @version
+    2.13.1
+
+  @note
+    Dependencies:
+    AGNSSManager.h
+
+  @author
+
+  @date
+    18/10/2026
+*/
+
+#include "AGNSSManager.h"
+
+using namespace me310;
+
+//! \brief Class Constructor
+/*!
+ * \param module      driver used for the GNSS commands
+ * \param provider    AGNSS provider, as in AT$AGNSS
+ * \param cid         PDP context checked by refresh()
+ * \param validity    validity of the assistance data in ms
+ */
+AGNSSManager::AGNSSManager(ME310 &module, int provider, int cid, uint32_t validity) :
+   _module(module), _provider(provider), _cid(cid), _validity(validity), _injected(false), _injectedAt(0),
+   _running(false), _type(AGNSS_START_COLD), _startedAt(0)
+{
+   memset(_ttff, 0, sizeof(_ttff));
+}
+
+//! \brief Refreshes the assistance data if it is stale and the PDP context is active
+/*!
+ * \param force    refreshes also valid assistance data
+ * \param aTimeout timeout in ms of each command
+ * \return RETURN_VALID if the data is valid, RETURN_ERROR if the context is not active or the injection failed
+ */
+ME310::return_t AGNSSManager::refresh(bool force, ME310::tout_t aTimeout)
+{
+   if(!force && assistance_valid())
+   {
+      return ME310::RETURN_VALID;
+   }
+   if(!pdp_active(aTimeout))
+   {
+      return ME310::RETURN_ERROR;
+   }
+   return inject(aTimeout);
+}
+
+//! \brief Downloads the assistance data
+/*! \details
+The provider is disabled and enabled again with AT$AGNSS, then AT$AGNSS? must report it as active.
+The PDP context must be active.
+ * \param aTimeout timeout in ms of each command
+ * \return return code, RETURN_ERROR if the provider is not reported as active
+ */
+ME310::return_t AGNSSManager::inject(ME310::tout_t aTimeout)
+{
+   ME310::return_t ret = _module.gnss_set_agnss_enable(_provider, 0, aTimeout);
+   if(ret == ME310::RETURN_VALID)
+   {
+      ret = _module.gnss_set_agnss_enable(_provider, 1, aTimeout);
+   }
+   if(ret == ME310::RETURN_VALID)
+   {
+      ret = _module.read_gnss_set_agnss_enable(aTimeout);
+   }
+   if(ret != ME310::RETURN_VALID)
+   {
+      return ret;
+   }
+   /* $AGNSS: <provider>,<active>,<requested> */
+   for(int i = 0; _module.buffer_cstr(i) != NULL; i++)
+   {
+      const char *line = _module.buffer_cstr(i);
+      if(strncmp(line, "$AGNSS:", 7) != 0)
+      {
+         continue;
+      }
+      char *next;
+      long provider = strtol(line + 7, &next, 10);
+      if(provider == _provider && *next == ',' && strtol(next + 1, NULL, 10) == 1)
+      {
+         _injected = true;
+         _injectedAt = millis();
+         return ME310::RETURN_VALID;
+      }
+   }
+   return ME310::RETURN_ERROR;
+}
+
+//! \brief Checks if the PDP context is active
+/*!
+ * \param aTimeout timeout in ms
+ * \return true if AT#SGACT? reports the context as active
+ */
+bool AGNSSManager::pdp_active(ME310::tout_t aTimeout)
+{
+   if(_module.read_context_activation(aTimeout) != ME310::RETURN_VALID)
+   {
+      return false;
+   }
+   /* #SGACT: <cid>,<stat> */
+   for(int i = 0; _module.buffer_cstr(i) != NULL; i++)
+   {
+      const char *line = _module.buffer_cstr(i);
+      if(strncmp(line, "#SGACT:", 7) != 0)
+      {
+         continue;
+      }
+      char *next;
+      long cid = strtol(line + 7, &next, 10);
+      if(cid == _cid && *next == ',')
+      {
+         return strtol(next + 1, NULL, 10) == 1;
+      }
+   }
+   return false;
+}
+
+//! \brief Checks if the assistance data is valid
+/*!
+ * \return true if the data has been injected less than the validity ago
+ */
+bool AGNSSManager::assistance_valid() const
+{
+   return _injected && (uint32_t)(millis() - _injectedAt) < _validity;
+}
+
+//! \brief Returns the age of the assistance data
+/*!
+ * \return age in ms, 0xFFFFFFFF if the data has never been injected
+ */
+uint32_t AGNSSManager::assistance_age() const
+{
+   return _injected ? (uint32_t)(millis() - _injectedAt) : 0xFFFFFFFF;
+}
+
+//! \brief Returns the fastest start type available
+/*!
+ * \return start type
+ */
+AGNSSManager::start_t AGNSSManager::best_start() const
+{
+   uint32_t age = _module.gnss_fix_age();
+   if(age < AGNSS_HOT_MAX_AGE_MS)
+   {
+      return AGNSS_START_HOT;
+   }
+   if(assistance_valid())
+   {
+      return AGNSS_START_ASSISTED;
+   }
+   if(age != 0xFFFFFFFF)
+   {
+      return AGNSS_START_WARM;
+   }
+   return AGNSS_START_COLD;
+}
+
+//! \brief Powers the GNSS controller on with a start type
+/*! \details
+Cold and warm starts reset the controller with AT$GPSR. The time to first fix is measured by poll().
+ * \param type    start type
+ * \param aTimeout timeout in ms of each command
+ * \return return code
+ */
+ME310::return_t AGNSSManager::start(start_t type, ME310::tout_t aTimeout)
+{
+   if(type >= AGNSS_START_TYPES)
+   {
+      return ME310::RETURN_ERROR;
+   }
+   ME310::return_t ret = _module.gnss_controller_power_management(1, aTimeout);
+   if(ret != ME310::RETURN_VALID)
+   {
+      return ret;
+   }
+   if(type == AGNSS_START_COLD || type == AGNSS_START_WARM)
+   {
+      ret = _module.gnss_reset_GPS_controller(type == AGNSS_START_COLD ? AGNSS_RESET_COLD : AGNSS_RESET_WARM, aTimeout);
+      if(ret != ME310::RETURN_VALID)
+      {
+         return ret;
+      }
+   }
+   _type = type;
+   _running = true;
+   _startedAt = millis();
+   _ttff[type].starts++;
+   return ME310::RETURN_VALID;
+}
+
+//! \brief Reads the position and records the time to first fix
+/*!
+ * \param fix    filled with the position
+ * \param aTimeout timeout in ms
+ * \return return code of ME310::gps_get_acquired_position()
+ */
+ME310::return_t AGNSSManager::poll(ME310::gnss_fix_t &fix, ME310::tout_t aTimeout)
+{
+   ME310::return_t ret = _module.gps_get_acquired_position(fix, aTimeout);
+   if(ret == ME310::RETURN_VALID && fix.valid && _running)
+   {
+      uint32_t ttff = fix.timestamp - _startedAt;
+      ttff_t &stats = _ttff[_type];
+      stats.fixes++;
+      stats.last = ttff;
+      stats.total += ttff;
+      if(stats.fixes == 1 || ttff < stats.min)
+      {
+         stats.min = ttff;
+      }
+      if(ttff > stats.max)
+      {
+         stats.max = ttff;
+      }
+      _running = false;
+   }
+   return ret;
+}
+
+//! \brief Powers the GNSS controller off
+/*! \details
+A start still waiting for the first fix is counted as failed.
+ * \param aTimeout timeout in ms
+ * \return return code
+ */
+ME310::return_t AGNSSManager::stop(ME310::tout_t aTimeout)
+{
+   _running = false;
+   return _module.gnss_controller_power_management(0, aTimeout);
+}
+
+//! \brief Returns the name of a start type
+/*!
+ * \param type    start type
+ * \return name of the start type
+ */
+const char *AGNSSManager::start_string(start_t type)
+{
+   switch(type)
+   {
+      case AGNSS_START_COLD: return "cold";
+      case AGNSS_START_WARM: return "warm";
+      case AGNSS_START_HOT: return "hot";
+      case AGNSS_START_ASSISTED: return "assisted";
+      default: return "unknown";
+   }
+}
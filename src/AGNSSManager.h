@@ -0,0 +1,114 @@
+/*Copyright (C) 2026 Telit Communications S.p.A. Italy - All Rights Reserved.*/
+/*    See LICENSE file in the project root for full license information.     */
+
+/**
+  @file
+    AGNSSManager.h
+
+  @brief
+    Lifecycle of the AGNSS assistance data and time to first fix per start type
+
+  @details
+    The class keeps track of the age of the assistance data downloaded through AT$AGNSS, refreshes it
+    when the PDP context is already active, and starts the GNSS controller with the fastest start type
+    allowed by the last fix and the assistance data, recording the time to first fix of each type.\n
+    No command is sent to activate the PDP context: the refresh only uses a context opened by the application.
+
+  @version
+    2.13.1
+
+  @note
+    Dependencies:
+    ME310.h
+
+  @author
+
+  @date
+    18/10/2026
+*/
+#ifndef __AGNSSMANAGER__H
+#define __AGNSSMANAGER__H
+
+/* Include files ================================================================================*/
+#include "ME310.h"
+
+namespace me310
+{
+   #define AGNSS_VALIDITY_MS 14400000UL      ///< Default validity of the assistance data, 4 hours
+   #define AGNSS_HOT_MAX_AGE_MS 7200000UL    ///< Max age of the last fix for a hot start, ephemeris validity
+   #define AGNSS_RESET_COLD 1                ///< AT$GPSR reset type of a cold start
+   #define AGNSS_RESET_WARM 2                ///< AT$GPSR reset type of a warm start
+
+   /*! \class AGNSSManager
+      \brief Manager of the AGNSS assistance data and of the GNSS starts
+      \details
+      The assistance data is injected by disabling and enabling the provider with AT$AGNSS, which makes the
+      module download it, and is considered valid when AT$AGNSS? reports the provider as active. refresh() is
+      meant to be called whenever the application has the PDP context up, e.g. right after an uplink: it
+      checks the context with AT#SGACT? only when the data is missing or older than the validity.\n
+      best_start() selects, from the fastest: hot if the driver has a fix younger than AGNSS_HOT_MAX_AGE_MS,
+      assisted if the assistance data is valid, warm if a fix has ever been read, cold otherwise. The last fix
+      is the one cached by ME310::gps_get_acquired_position(gnss_fix_t&).
+   */
+   class AGNSSManager
+   {
+      public:
+
+      typedef enum
+      {
+         AGNSS_START_COLD = 0,         ///< AT$GPSR=1, no data kept
+         AGNSS_START_WARM,             ///< AT$GPSR=2, almanac and time kept
+         AGNSS_START_HOT,              ///< Ephemeris kept, no reset
+         AGNSS_START_ASSISTED,         ///< Valid assistance data, no reset
+         AGNSS_START_TYPES             ///< Number of start types
+      } start_t;
+
+      /*! \struct ttff_t
+         \brief Time to first fix of a start type, in ms
+      */
+      typedef struct
+      {
+         uint32_t starts;              ///< Starts of this type
+         uint32_t fixes;               ///< Starts ended with a fix
+         uint32_t last;                ///< Time to first fix of the last start
+         uint32_t min;                 ///< Min time to first fix
+         uint32_t max;                 ///< Max time to first fix
+         uint32_t total;               ///< Sum of the times to first fix
+      } ttff_t;
+
+      AGNSSManager(ME310 &module, int provider, int cid = 1, uint32_t validity = AGNSS_VALIDITY_MS);
+
+      ME310::return_t refresh(bool force = false, ME310::tout_t aTimeout = ME310::TOUT_1SEC);
+      ME310::return_t inject(ME310::tout_t aTimeout = ME310::TOUT_1SEC);
+      bool pdp_active(ME310::tout_t aTimeout = ME310::TOUT_1SEC);
+      bool assistance_valid() const;
+      uint32_t assistance_age() const;
+
+      start_t best_start() const;
+      ME310::return_t start(ME310::tout_t aTimeout = ME310::TOUT_1SEC) { return start(best_start(), aTimeout); }   //!< Starts with the fastest start type
+      ME310::return_t start(start_t type, ME310::tout_t aTimeout = ME310::TOUT_1SEC);
+      ME310::return_t poll(ME310::gnss_fix_t &fix, ME310::tout_t aTimeout = ME310::TOUT_1SEC);
+      ME310::return_t stop(ME310::tout_t aTimeout = ME310::TOUT_1SEC);
+
+      bool running() const { return _running; }                         //!< Returns true if a start is waiting for the first fix
+      start_t start_type() const { return _type; }                      //!< Returns the type of the last start
+      const ttff_t &ttff(start_t type) const { return _ttff[type < AGNSS_START_TYPES ? type : AGNSS_START_COLD]; }   //!< Returns the statistics of a start type
+
+      static const char *start_string(start_t type);
+
+      private:
+
+      ME310 &_module;                  //!< Driver used for the GNSS commands
+      int _provider;                   //!< AGNSS provider
+      int _cid;                        //!< PDP context used for the download
+      uint32_t _validity;              //!< Validity of the assistance data, in ms
+      bool _injected;                  //!< Assistance data injected at least once
+      uint32_t _injectedAt;            //!< millis() of the last injection
+      bool _running;                   //!< Waiting for the first fix
+      start_t _type;                   //!< Type of the last start
+      uint32_t _startedAt;             //!< millis() of the last start
+      ttff_t _ttff[AGNSS_START_TYPES]; //!< Statistics of each start type
+   };
+} // end namespace
+
+#endif //__AGNSSMANAGER__H
@@ -0,0 +1,232 @@
+/*Copyright (C) 2026 Telit Communications S.p.A. Italy - All Rights Reserved.*/
+/*    See LICENSE file in the project root for full license information.     */
+
+/**
+  @file
+    GNSSScheduler.cpp
+
+  @brief
+    Time sharing of the RF path between GNSS fixes and WWAN uplinks
+
+  @details
+    The class powers the GNSS controller on for a fix window at a fixed period, with the GNSS runtime
+    priority, and powers it off with the WWAN priority when the fix is acquired or the window expires.\n
+
+  @version
+    2.13.1
+
+  @note
+    Dependencies:
+    GNSSScheduler.h
+
+  @author
+
+  @date
+    18/10/2026
+*/
+
+#include "GNSSScheduler.h"
+
+using namespace me310;
+
+//! \brief Class Constructor
+/*!
+ * \param module         driver used for the GNSS commands
+ * \param period         interval in ms between the starts of the fix windows
+ * \param fixTimeout     max duration in ms of a fix window
+ * \param uplinkDelay    max time in ms an uplink request is held waiting for a fix window to end
+ */
+GNSSScheduler::GNSSScheduler(ME310 &module, uint32_t period, uint32_t fixTimeout, uint32_t uplinkDelay) :
+   _module(module), _period(period), _fixTimeout(fixTimeout), _uplinkDelay(uplinkDelay),
+   _uplink(NULL), _uplinkContext(NULL), _handler(NULL), _handlerContext(NULL), _phase(GNSS_SCHEDULER_IDLE),
+   _nextFix(0), _windowStart(0), _lastPoll(0), _pending(false), _flush(false), _deferred(false), _requested(0)
+{
+   memset(&_fix, 0, sizeof(_fix));
+   memset(&_stats, 0, sizeof(_stats));
+}
+
+//! \brief Powers the GNSS controller off and gives the priority to WWAN
+/*! \details
+The first fix window starts at the next run().
+ * \param aTimeout timeout in ms of each command
+ * \return return code
+ */
+ME310::return_t GNSSScheduler::begin(ME310::tout_t aTimeout)
+{
+   _phase = GNSS_SCHEDULER_IDLE;
+   _nextFix = millis();
+   ME310::return_t ret = _module.gnss_controller_power_management(0, aTimeout);
+   if(ret != ME310::RETURN_VALID)
+   {
+      return ret;
+   }
+   return _module.gnss_configuration(GNSS_SCHEDULER_RUNTIME_PRIORITY, GNSS_SCHEDULER_PRIORITY_WWAN, aTimeout);
+}
+
+//! \brief Runs a step of the scheduler
+/*! \details
+Starts or ends a fix window, polls the position or sends the pending uplinks, as needed.
+ * \param aTimeout timeout in ms of each command
+ * \return return code of the commands sent, RETURN_VALID if none
+ */
+ME310::return_t GNSSScheduler::run(ME310::tout_t aTimeout)
+{
+   uint32_t now = millis();
+   bool expired = _pending && (now - _requested >= _uplinkDelay);
+   ME310::return_t ret = ME310::RETURN_VALID;
+   if(_phase == GNSS_SCHEDULER_IDLE)
+   {
+      if(_pending && (expired || _flush))
+      {
+         send_uplink(now);
+      }
+      _flush = false;
+      if((int32_t)(now - _nextFix) >= 0)
+      {
+         ret = start_window(now, aTimeout);
+      }
+      return ret;
+   }
+
+   if(expired && !_deferred)
+   {
+      /* the uplink cannot wait the end of the window */
+      ret = _module.gnss_configuration(GNSS_SCHEDULER_RUNTIME_PRIORITY, GNSS_SCHEDULER_PRIORITY_WWAN, aTimeout);
+      if(ret != ME310::RETURN_VALID)
+      {
+         return ret;
+      }
+      if(send_uplink(now))
+      {
+         _stats.preemptions++;
+      }
+      else
+      {
+         _deferred = true;
+      }
+      ret = _module.gnss_configuration(GNSS_SCHEDULER_RUNTIME_PRIORITY, GNSS_SCHEDULER_PRIORITY_GNSS, aTimeout);
+      if(ret != ME310::RETURN_VALID)
+      {
+         return ret;
+      }
+      now = millis();
+   }
+   if(now - _lastPoll >= GNSS_SCHEDULER_POLL_MS)
+   {
+      _lastPoll = now;
+      ret = _module.gps_get_acquired_position(_fix, aTimeout);
+      if(ret == ME310::RETURN_VALID && _fix.valid)
+      {
+         uint32_t ttff = now - _windowStart;
+         _stats.fixes++;
+         _stats.last_ttff = ttff;
+         _stats.total_ttff += ttff;
+         if(ttff > _stats.max_ttff)
+         {
+            _stats.max_ttff = ttff;
+         }
+         if(_handler != NULL)
+         {
+            _handler(_fix, _handlerContext);
+         }
+         return end_window(now, aTimeout);
+      }
+   }
+   if(now - _windowStart >= _fixTimeout)
+   {
+      _stats.timeouts++;
+      return end_window(now, aTimeout);
+   }
+   return ret;
+}
+
+//! \brief Requests an uplink
+/*! \details
+To be called when data is queued for sending; requests made before the batch is sent are merged.
+ */
+void GNSSScheduler::request_uplink()
+{
+   if(!_pending)
+   {
+      _pending = true;
+      _requested = millis();
+   }
+}
+
+//! \brief Starts a fix window at the next run(), without waiting for the period
+void GNSSScheduler::request_fix()
+{
+   if(_phase == GNSS_SCHEDULER_IDLE)
+   {
+      _nextFix = millis();
+   }
+}
+
+//! \brief Gives the priority to GNSS and powers the GNSS controller on
+/*!
+ * \param now    current time
+ * \param aTimeout timeout in ms of each command
+ * \return return code
+ */
+ME310::return_t GNSSScheduler::start_window(uint32_t now, ME310::tout_t aTimeout)
+{
+   ME310::return_t ret = _module.gnss_configuration(GNSS_SCHEDULER_RUNTIME_PRIORITY, GNSS_SCHEDULER_PRIORITY_GNSS, aTimeout);
+   if(ret == ME310::RETURN_VALID)
+   {
+      ret = _module.gnss_controller_power_management(1, aTimeout);
+   }
+   _nextFix = now + _period;
+   if(ret != ME310::RETURN_VALID)
+   {
+      /* retried at the next period, the priority goes back to WWAN */
+      _module.gnss_configuration(GNSS_SCHEDULER_RUNTIME_PRIORITY, GNSS_SCHEDULER_PRIORITY_WWAN, aTimeout);
+      return ret;
+   }
+   _phase = GNSS_SCHEDULER_FIX;
+   _windowStart = now;
+   _lastPoll = now;
+   _stats.windows++;
+   return ME310::RETURN_VALID;
+}
+
+//! \brief Powers the GNSS controller off and gives the priority to WWAN
+/*! \details
+The pending uplinks are sent at the next run().
+ * \param now    current time
+ * \param aTimeout timeout in ms of each command
+ * \return return code
+ */
+ME310::return_t GNSSScheduler::end_window(uint32_t now, ME310::tout_t aTimeout)
+{
+   _phase = GNSS_SCHEDULER_IDLE;
+   _flush = true;
+   _deferred = false;
+   _stats.gnss_on_time += now - _windowStart;
+   ME310::return_t ret = _module.gnss_controller_power_management(0, aTimeout);
+   ME310::return_t priority = _module.gnss_configuration(GNSS_SCHEDULER_RUNTIME_PRIORITY, GNSS_SCHEDULER_PRIORITY_WWAN, aTimeout);
+   return (ret != ME310::RETURN_VALID) ? ret : priority;
+}
+
+//! \brief Calls the uplink callback and updates the statistics
+/*!
+ * \param now    current time
+ * \return false if the callback refused the batch
+ */
+bool GNSSScheduler::send_uplink(uint32_t now)
+{
+   if(_uplink != NULL && !_uplink(_uplinkContext))
+   {
+      _stats.failures++;
+      return false;
+   }
+   uint32_t delay = now - _requested;
+   _pending = false;
+   _stats.uplinks++;
+   _stats.last_uplink_delay = delay;
+   _stats.total_uplink_delay += delay;
+   if(delay > _stats.max_uplink_delay)
+   {
+      _stats.max_uplink_delay = delay;
+   }
+   return true;
+}
@@ -0,0 +1,130 @@
+/*Copyright (C) 2026 Telit Communications S.p.A. Italy - All Rights Reserved.*/
+/*    See LICENSE file in the project root for full license information.     */
+
+/**
+  @file
+    GNSSScheduler.h
+
+  @brief
+    Time sharing of the RF path between GNSS fixes and WWAN uplinks
+
+  @details
+    The class powers the GNSS controller on for a fix window at a fixed period, with the GNSS runtime
+    priority, and powers it off with the WWAN priority when the fix is acquired or the window expires.
+    Uplinks requested by the application are held and sent in batches after the fix windows.\n
+    Time to first fix and uplink delays are collected to evaluate the cost of the sharing.
+
+  @version
+    2.13.1
+
+  @note
+    Dependencies:
+    ME310.h
+
+  @author
+
+  @date
+    18/10/2026
+*/
+#ifndef __GNSSSCHEDULER__H
+#define __GNSSSCHEDULER__H
+
+/* Include files ================================================================================*/
+#include "ME310.h"
+
+namespace me310
+{
+   #define GNSS_SCHEDULER_RUNTIME_PRIORITY 3   ///< AT$GPSCFG parameter of the runtime priority
+   #define GNSS_SCHEDULER_PRIORITY_GNSS 0      ///< Runtime priority value giving the RF path to GNSS
+   #define GNSS_SCHEDULER_PRIORITY_WWAN 1      ///< Runtime priority value giving the RF path to WWAN
+   #define GNSS_SCHEDULER_POLL_MS 1000         ///< Interval between AT$GPSACP polls during a fix window
+
+   /*! \class GNSSScheduler
+      \brief Scheduler of GNSS fix windows and WWAN uplinks
+      \details
+      run() must be called often from the application loop; it sends the commands of at most one step and
+      returns. The application queues its socket or MQTT sends as usual and calls request_uplink(): the uplink
+      callback is then called, with the WWAN priority, when the oldest request has waited the uplink delay or
+      right after a fix window, so that the data sent can include the new position.\n
+      When a request reaches the uplink delay during a fix window, the window is not aborted: the priority is
+      moved to WWAN for the uplink and back to GNSS, and the event is counted as a preemption; the time to fix
+      of that window includes the uplink. If the callback refuses the preemptive uplink, the batch waits for the
+      end of the window instead of switching the priority again at each run().
+   */
+   class GNSSScheduler
+   {
+      public:
+
+      typedef enum
+      {
+         GNSS_SCHEDULER_IDLE = 0,      ///< GNSS powered off, WWAN priority
+         GNSS_SCHEDULER_FIX            ///< Fix window, GNSS powered on with GNSS priority
+      } phase_t;
+
+      /*! \struct stats_t
+         \brief Cost of the time sharing, times in ms
+      */
+      typedef struct
+      {
+         uint32_t windows;             ///< Fix windows started
+         uint32_t fixes;               ///< Fix windows ended with a valid fix
+         uint32_t timeouts;            ///< Fix windows expired without a fix
+         uint32_t last_ttff;           ///< Time to fix of the last valid fix
+         uint32_t max_ttff;            ///< Max time to fix
+         uint32_t total_ttff;          ///< Sum of the times to fix
+         uint32_t gnss_on_time;        ///< Time spent with the GNSS controller powered on
+         uint32_t uplinks;             ///< Uplink batches sent
+         uint32_t failures;            ///< Uplink batches refused by the callback, retried at the next run()
+         uint32_t preemptions;         ///< Uplink batches sent during a fix window
+         uint32_t last_uplink_delay;   ///< Delay of the last batch, from its first request to the send
+         uint32_t max_uplink_delay;    ///< Max delay of a batch
+         uint32_t total_uplink_delay;  ///< Sum of the delays of the batches
+      } stats_t;
+
+      typedef bool (*uplink_t)(void *context);   //!< Sends the queued uplink data, returns false if it must be retried
+      typedef void (*fix_handler_t)(const ME310::gnss_fix_t &fix, void *context);   //!< Receives the fix of each window
+
+      GNSSScheduler(ME310 &module, uint32_t period, uint32_t fixTimeout, uint32_t uplinkDelay);
+
+      void set_uplink(uplink_t uplink, void *context = NULL) { _uplink = uplink; _uplinkContext = context; }   //!< Sets the uplink callback
+      void set_fix_handler(fix_handler_t handler, void *context = NULL) { _handler = handler; _handlerContext = context; }   //!< Sets the fix handler
+
+      ME310::return_t begin(ME310::tout_t aTimeout = ME310::TOUT_1SEC);
+      ME310::return_t run(ME310::tout_t aTimeout = ME310::TOUT_1SEC);
+      void request_uplink();
+      void request_fix();
+
+      phase_t phase() const { return _phase; }                  //!< Returns the current phase
+      bool uplink_pending() const { return _pending; }          //!< Returns true if an uplink has been requested and not sent yet
+      const ME310::gnss_fix_t &fix() const { return _fix; }     //!< Returns the last position read
+      const stats_t &stats() const { return _stats; }           //!< Returns the time sharing statistics
+      void reset_stats() { memset(&_stats, 0, sizeof(_stats)); }   //!< Clears the statistics
+
+      private:
+
+      ME310::return_t start_window(uint32_t now, ME310::tout_t aTimeout);
+      ME310::return_t end_window(uint32_t now, ME310::tout_t aTimeout);
+      bool send_uplink(uint32_t now);
+
+      ME310 &_module;                  //!< Driver used for the GNSS commands
+      uint32_t _period;                //!< Interval between the starts of the fix windows
+      uint32_t _fixTimeout;            //!< Max duration of a fix window
+      uint32_t _uplinkDelay;           //!< Max time an uplink request is held
+      uplink_t _uplink;                //!< Uplink callback
+      void *_uplinkContext;            //!< Pointer passed back to the uplink callback
+      fix_handler_t _handler;          //!< Fix handler
+      void *_handlerContext;           //!< Pointer passed back to the fix handler
+      phase_t _phase;                  //!< Current phase
+      uint32_t _nextFix;               //!< Start time of the next fix window
+      uint32_t _windowStart;           //!< Start time of the current fix window
+      uint32_t _lastPoll;              //!< Time of the last AT$GPSACP poll
+      bool _pending;                   //!< Uplink requested
+      bool _flush;                     //!< A fix window just ended, pending uplinks are sent
+      bool _deferred;                  //!< A preemptive uplink has been refused, the batch waits for the end of the window
+      uint32_t _requested;             //!< Time of the first request of the pending batch
+      ME310::gnss_fix_t _fix;          //!< Last position read
+      stats_t _stats;                  //!< Time sharing statistics
+   };
+} // end namespace
+
+#endif //__GNSSSCHEDULER__H
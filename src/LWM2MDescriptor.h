@@ -0,0 +1,240 @@
+/*Copyright (C) 2026 Telit Communications S.p.A. Italy - All Rights Reserved.*/
+/*    See LICENSE file in the project root for full license information.     */
+
+/**
+  @file
+    LWM2MDescriptor.h
+
+  @brief
+    Compile time descriptors of LWM2M objects and resources
+
+  @details
+    The templates describe the identifier, type and multiplicity of the resources of an object,
+    so that the writes are checked at compile time and dispatched to the AT#LWM2MSET variant
+    or LWM2MObjectBuilder method of the resource type without runtime lookups.\n
+    The descriptor tables of an object are generated from its OMA xml definition with
+    extras/lwm2m_codegen/lwm2m_codegen.py.
+
+  @version
+    2.13.1
+
+  @note
+    Dependencies:
+    ME310.h
+    LWM2MObjectBuilder.h
+
+  @author
+
+  @date
+    18/10/2026
+*/
+#ifndef __LWM2MDESCRIPTOR__H
+#define __LWM2MDESCRIPTOR__H
+
+/* Include files ================================================================================*/
+#include "ME310.h"
+#include "LWM2MObjectBuilder.h"
+
+namespace me310
+{
+   /*! \enum lwm2m_type_t
+      \brief Resource data types of the OMA object definitions
+   */
+   typedef enum
+   {
+      LWM2M_TYPE_NONE = 0,      ///< Executable resource, no value
+      LWM2M_TYPE_INTEGER,       ///< Integer and Unsigned Integer
+      LWM2M_TYPE_FLOAT,         ///< Float
+      LWM2M_TYPE_BOOLEAN,       ///< Boolean
+      LWM2M_TYPE_STRING,        ///< String and Corelnk
+      LWM2M_TYPE_OPAQUE,        ///< Opaque
+      LWM2M_TYPE_TIME,          ///< Time
+      LWM2M_TYPE_OBJLNK         ///< Objlnk
+   } lwm2m_type_t;
+
+   /*! \struct lwm2m_objlnk_t
+      \brief Object link value
+   */
+   typedef struct
+   {
+      int objID;                ///< Linked object identifier
+      int instanceID;           ///< Linked object instance identifier
+   } lwm2m_objlnk_t;
+
+   /*! \struct lwm2m_opaque_t
+      \brief Opaque value
+   */
+   typedef struct
+   {
+      const uint8_t *data;      ///< Value bytes
+      size_t len;               ///< Number of bytes
+   } lwm2m_opaque_t;
+
+   /*! \struct LWM2MTypeTraits
+      \brief Value type and write functions of a resource data type
+      \details
+      Only the types that can be written have a specialization, so writing an executable resource does not compile.
+      Opaque resources can only be written through LWM2MObjectBuilder.
+   */
+   template<lwm2m_type_t Type> struct LWM2MTypeTraits;
+
+   template<> struct LWM2MTypeTraits<LWM2M_TYPE_INTEGER>
+   {
+      typedef int value_t;
+      static ME310::return_t set(ME310 &module, int objID, int instanceID, int resourceID, int resourceInstance, value_t value, ME310::tout_t aTimeout)
+      { return module.LWM2M_set_resource_int(objID, instanceID, resourceID, resourceInstance, value, aTimeout); }
+      static bool add(LWM2MObjectBuilder &builder, int resourceID, int resourceInstance, value_t value)
+      { return builder.add_int(resourceID, value, resourceInstance); }
+   };
+
+   template<> struct LWM2MTypeTraits<LWM2M_TYPE_FLOAT>
+   {
+      typedef float value_t;
+      static ME310::return_t set(ME310 &module, int objID, int instanceID, int resourceID, int resourceInstance, value_t value, ME310::tout_t aTimeout)
+      { return module.LWM2M_set_resource_float(objID, instanceID, resourceID, resourceInstance, value, aTimeout); }
+      static bool add(LWM2MObjectBuilder &builder, int resourceID, int resourceInstance, value_t value)
+      { return builder.add_float(resourceID, value, resourceInstance); }
+   };
+
+   template<> struct LWM2MTypeTraits<LWM2M_TYPE_BOOLEAN>
+   {
+      typedef bool value_t;
+      static ME310::return_t set(ME310 &module, int objID, int instanceID, int resourceID, int resourceInstance, value_t value, ME310::tout_t aTimeout)
+      { return module.LWM2M_set_resource_bool(objID, instanceID, resourceID, resourceInstance, value ? 1 : 0, aTimeout); }
+      static bool add(LWM2MObjectBuilder &builder, int resourceID, int resourceInstance, value_t value)
+      { return builder.add_bool(resourceID, value, resourceInstance); }
+   };
+
+   template<> struct LWM2MTypeTraits<LWM2M_TYPE_STRING>
+   {
+      typedef const char *value_t;
+      static ME310::return_t set(ME310 &module, int objID, int instanceID, int resourceID, int resourceInstance, value_t value, ME310::tout_t aTimeout)
+      { return module.LWM2M_set_resource_string(objID, instanceID, resourceID, resourceInstance, const_cast<char*>(value), aTimeout); }
+      static bool add(LWM2MObjectBuilder &builder, int resourceID, int resourceInstance, value_t value)
+      { return builder.add_string(resourceID, value, resourceInstance); }
+   };
+
+   template<> struct LWM2MTypeTraits<LWM2M_TYPE_OPAQUE>
+   {
+      typedef lwm2m_opaque_t value_t;
+      static bool add(LWM2MObjectBuilder &builder, int resourceID, int resourceInstance, value_t value)
+      { return builder.add_opaque(resourceID, value.data, value.len, resourceInstance); }
+   };
+
+   template<> struct LWM2MTypeTraits<LWM2M_TYPE_TIME>
+   {
+      typedef uint32_t value_t;
+      static ME310::return_t set(ME310 &module, int objID, int instanceID, int resourceID, int resourceInstance, value_t value, ME310::tout_t aTimeout)
+      { return module.LWM2M_set_resource_time(objID, instanceID, resourceID, resourceInstance, value, aTimeout); }
+      static bool add(LWM2MObjectBuilder &builder, int resourceID, int resourceInstance, value_t value)
+      { return builder.add_time(resourceID, value, resourceInstance); }
+   };
+
+   template<> struct LWM2MTypeTraits<LWM2M_TYPE_OBJLNK>
+   {
+      typedef lwm2m_objlnk_t value_t;
+      static ME310::return_t set(ME310 &module, int objID, int instanceID, int resourceID, int resourceInstance, value_t value, ME310::tout_t aTimeout)
+      {
+         char link[24];
+         snprintf(link, sizeof(link), "%d:%d", value.objID, value.instanceID);
+         return module.LWM2M_set_resource_object_link(objID, instanceID, resourceID, resourceInstance, link, aTimeout);
+      }
+      static bool add(LWM2MObjectBuilder &builder, int resourceID, int resourceInstance, value_t value)
+      { return builder.add_object_link(resourceID, value.objID, value.instanceID, resourceInstance); }
+   };
+
+   /*! \struct LWM2MObject
+      \brief Descriptor of an object
+   */
+   template<int ObjID, bool Multiple>
+   struct LWM2MObject
+   {
+      static constexpr int id = ObjID;                 //!< Object identifier
+      static constexpr bool multiple = Multiple;       //!< True if the object has multiple instances
+   };
+
+   /*! \struct LWM2MResourceInstance
+      \brief Instance of a multiple resource, returned by LWM2MResource::operator[]
+   */
+   template<class Resource>
+   struct LWM2MResourceInstance
+   {
+      typedef Resource resource_t;                     //!< Resource descriptor
+      int index;                                       //!< Resource instance identifier
+   };
+
+   /*! \struct LWM2MResource
+      \brief Descriptor of a resource
+      \details
+      Single resources are written passing the descriptor itself, multiple resources passing one of
+      their instances, e.g. RESOURCE[2]: the other combinations do not compile.
+   */
+   template<int ObjID, int ResID, lwm2m_type_t Type, bool Multiple>
+   struct LWM2MResource
+   {
+      static constexpr int objID = ObjID;              //!< Object identifier
+      static constexpr int id = ResID;                 //!< Resource identifier
+      static constexpr lwm2m_type_t type = Type;       //!< Resource data type
+      static constexpr bool multiple = Multiple;       //!< True if the resource has multiple instances
+      typedef typename LWM2MTypeTraits<Type == LWM2M_TYPE_NONE ? LWM2M_TYPE_INTEGER : Type>::value_t value_t;   //!< Value type
+
+      //! \brief Selects an instance of a multiple resource
+      constexpr LWM2MResourceInstance<LWM2MResource> operator[](int index) const
+      {
+         static_assert(Multiple, "single instance resource: pass the resource without index");
+         return LWM2MResourceInstance<LWM2MResource>{index};
+      }
+   };
+
+   //! \brief Sets a single instance resource with the AT#LWM2MSET variant of its type
+   template<class Resource>
+   ME310::return_t LWM2M_set(ME310 &module, Resource, int instanceID, typename Resource::value_t value, ME310::tout_t aTimeout = ME310::TOUT_100MS)
+   {
+      static_assert(!Resource::multiple, "multiple instance resource: select the instance with []");
+      static_assert(Resource::type != LWM2M_TYPE_NONE, "executable resource has no value");
+      return LWM2MTypeTraits<Resource::type>::set(module, Resource::objID, instanceID, Resource::id, 0, value, aTimeout);
+   }
+
+   //! \brief Sets an instance of a multiple resource with the AT#LWM2MSET variant of its type
+   template<class Resource>
+   ME310::return_t LWM2M_set(ME310 &module, LWM2MResourceInstance<Resource> resource, int instanceID, typename Resource::value_t value, ME310::tout_t aTimeout = ME310::TOUT_100MS)
+   {
+      static_assert(Resource::type != LWM2M_TYPE_NONE, "executable resource has no value");
+      return LWM2MTypeTraits<Resource::type>::set(module, Resource::objID, instanceID, Resource::id, resource.index, value, aTimeout);
+   }
+
+   /*! \class LWM2MObjectWriter
+      \brief LWM2MObjectBuilder restricted to the resources of an object
+      \details
+      add() checks at compile time that the resource belongs to the object and calls the builder
+      method of its type.
+   */
+   template<class Object>
+   class LWM2MObjectWriter : public LWM2MObjectBuilder
+   {
+      public:
+
+      explicit LWM2MObjectWriter(int instanceID = 0) : LWM2MObjectBuilder(Object::id, instanceID) {}   //!< Class Constructor
+
+      //! \brief Adds the value of a single instance resource
+      template<class Resource>
+      bool add(Resource, typename Resource::value_t value)
+      {
+         static_assert(Resource::objID == Object::id, "resource of another object");
+         static_assert(!Resource::multiple, "multiple instance resource: select the instance with []");
+         static_assert(Resource::type != LWM2M_TYPE_NONE, "executable resource has no value");
+         return LWM2MTypeTraits<Resource::type>::add(*this, Resource::id, -1, value);
+      }
+
+      //! \brief Adds the value of an instance of a multiple resource
+      template<class Resource>
+      bool add(LWM2MResourceInstance<Resource> resource, typename Resource::value_t value)
+      {
+         static_assert(Resource::objID == Object::id, "resource of another object");
+         static_assert(Resource::type != LWM2M_TYPE_NONE, "executable resource has no value");
+         return LWM2MTypeTraits<Resource::type>::add(*this, Resource::id, resource.index, value);
+      }
+   };
+} // end namespace
+
+#endif //__LWM2MDESCRIPTOR__H
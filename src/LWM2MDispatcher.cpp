@@ -0,0 +1,107 @@
+/*Copyright (C) 2026 Telit Communications S.p.A. Italy - All Rights Reserved.*/
+/*    See LICENSE file in the project root for full license information.     */
+
+/**
+  @file
+    LWM2MDispatcher.cpp
+
+  @brief
+    Dispatcher of the LWM2M events to per-object handlers
+
+  @details
+    The class routes the events reported by the #LWM2MRING and #LWM2MEVT unsolicited codes
+    to the handlers registered for their object.\n
+
+  @version
+    2.13.1
+
+  @note
+    Dependencies:
+    LWM2MDispatcher.h
+
+  @author
+
+  @date
+    18/10/2026
+*/
+
+#include "LWM2MDispatcher.h"
+
+using namespace me310;
+
+//! \brief Class Constructor
+/*!
+ * \param table    initial handler table, may be NULL
+ * \param count    number of entries of the table, the ones exceeding LWM2M_DISPATCHER_MAX_HANDLERS are ignored
+ */
+LWM2MDispatcher::LWM2MDispatcher(const entry_t *table, int count) : _count(0)
+{
+   for(int i = 0; table != NULL && i < count; i++)
+   {
+      add(table[i].objID, table[i].handler, table[i].context);
+   }
+}
+
+//! \brief Adds a handler to the table
+/*! \details
+More handlers can be registered for the same object, they are called in order of registration.
+ * \param objID      object identifier, LWM2M_ANY_OBJECT for all the events
+ * \param handler    function called for the events of the object
+ * \param context    pointer passed back to the handler
+ * \return false if the table is full
+ */
+bool LWM2MDispatcher::add(int objID, handler_t handler, void *context)
+{
+   if(handler == NULL || _count >= LWM2M_DISPATCHER_MAX_HANDLERS)
+   {
+      return false;
+   }
+   _table[_count].objID = objID;
+   _table[_count].handler = handler;
+   _table[_count].context = context;
+   _count++;
+   return true;
+}
+
+//! \brief Removes the handlers of an object
+/*!
+ * \param objID    object identifier, as passed to add()
+ * \return true if at least a handler was removed
+ */
+bool LWM2MDispatcher::remove(int objID)
+{
+   int kept = 0;
+   for(int i = 0; i < _count; i++)
+   {
+      if(_table[i].objID != objID)
+      {
+         _table[kept++] = _table[i];
+      }
+   }
+   bool removed = (kept != _count);
+   _count = kept;
+   return removed;
+}
+
+//! \brief Dispatches an event to the handlers of its object
+/*!
+ * \param event    event reported by the module
+ * \return number of handlers called
+ */
+int LWM2MDispatcher::dispatch(const ME310::lwm2m_event_t &event)
+{
+   int called = 0;
+   for(int pass = 0; pass < 2; pass++)
+   {
+      for(int i = 0; i < _count; i++)
+      {
+         bool any = (_table[i].objID == LWM2M_ANY_OBJECT);
+         if((pass == 0 && !any && _table[i].objID == event.objID) || (pass == 1 && any))
+         {
+            _table[i].handler(event, _table[i].context);
+            called++;
+         }
+      }
+   }
+   return called;
+}
@@ -0,0 +1,78 @@
+/*Copyright (C) 2026 Telit Communications S.p.A. Italy - All Rights Reserved.*/
+/*    See LICENSE file in the project root for full license information.     */
+
+/**
+  @file
+    LWM2MDispatcher.h
+
+  @brief
+    Dispatcher of the LWM2M events to per-object handlers
+
+  @details
+    The class routes the events reported by the #LWM2MRING and #LWM2MEVT unsolicited codes
+    to the handlers registered for their object.\n
+    Handlers are stored in a fixed size table, no memory is allocated.
+
+  @version
+    2.13.1
+
+  @note
+    Dependencies:
+    ME310.h
+
+  @author
+
+  @date
+    18/10/2026
+*/
+#ifndef __LWM2MDISPATCHER__H
+#define __LWM2MDISPATCHER__H
+
+/* Include files ================================================================================*/
+#include "ME310.h"
+
+namespace me310
+{
+   #define LWM2M_DISPATCHER_MAX_HANDLERS 8   ///< Max number of handlers in the table
+   #define LWM2M_ANY_OBJECT -1               ///< Object identifier of the handlers called for every event
+
+   /*! \class LWM2MDispatcher
+      \brief Routes LWM2M events to handlers by object identifier
+      \details
+      The table can be given to the constructor, usually as a static array, or filled with add().
+      Each event is passed to the handlers of its object, then to the handlers registered for
+      LWM2M_ANY_OBJECT, which also receive the #LWM2MEVT events that have no object.\n
+      The dispatcher can be attached to the driver with ME310::LWM2M_set_dispatcher(), so that the events
+      processed by ME310::LWM2M_process_events() are dispatched automatically.
+   */
+   class LWM2MDispatcher
+   {
+      public:
+
+      typedef void (*handler_t)(const ME310::lwm2m_event_t &event, void *context);   //!< Event handler
+
+      /*! \struct entry_t
+         \brief Handler table entry
+      */
+      typedef struct
+      {
+         int objID;            ///< Object identifier, LWM2M_ANY_OBJECT for all the events
+         handler_t handler;    ///< Function called for the events of the object
+         void *context;        ///< Pointer passed back to the handler
+      } entry_t;
+
+      LWM2MDispatcher(const entry_t *table = NULL, int count = 0);
+
+      bool add(int objID, handler_t handler, void *context = NULL);
+      bool remove(int objID);
+      void clear() { _count = 0; }      //!< Removes all the handlers
+      int dispatch(const ME310::lwm2m_event_t &event);
+
+      private:
+
+      entry_t _table[LWM2M_DISPATCHER_MAX_HANDLERS];   //!< Handler table
+      int _count;                                      //!< Number of used entries
+   };
+} // end namespace
+
+#endif //__LWM2MDISPATCHER__H
@@ -0,0 +1,328 @@
+/*Copyright (C) 2026 Telit Communications S.p.A. Italy - All Rights Reserved.*/
+/*    See LICENSE file in the project root for full license information.     */
+
+/**
+  @file
+    LWM2MObjectBuilder.cpp
+
+  @brief
+    Builder of the AT#LWM2MOBJSET json payload
+
+  @details
+    The class accumulates typed resource writes of an object instance into the LWM2M json format
+    accepted by AT#LWM2MOBJSET.\n
+
+  @version
+    2.13.1
+
+  @note
+    Dependencies:
+    LWM2MObjectBuilder.h
+
+  @author
+
+  @date
+    18/10/2026
+*/
+
+#include "LWM2MObjectBuilder.h"
+#include <string.h>
+#include <math.h>
+
+using namespace me310;
+
+//! \brief Class Constructor
+/*!
+ * \param objID         identifies the object LWM2M
+ * \param instanceID    identifies the instance of the object
+ */
+LWM2MObjectBuilder::LWM2MObjectBuilder(int objID, int instanceID)
+{
+   reset(objID, instanceID);
+}
+
+//! \brief Removes all the resources added
+/*!
+ */
+void LWM2MObjectBuilder::reset()
+{
+   reset(_objID, _instanceID);
+}
+
+//! \brief Removes all the resources added and selects another object instance
+/*!
+ * \param objID         identifies the object LWM2M
+ * \param instanceID    identifies the instance of the object
+ */
+void LWM2MObjectBuilder::reset(int objID, int instanceID)
+{
+   _objID = objID;
+   _instanceID = instanceID;
+   _len = snprintf(_buffer, LWM2M_OBJECT_BUFFSIZE, "{\"bn\":\"/%d/%d/\",\"e\":[", objID, instanceID);
+   _count = 0;
+   _overflow = false;
+}
+
+//! \brief Adds an integer resource
+/*!
+ * \param resourceID          identifies the resource of the object
+ * \param value               value to be set
+ * \param resourceInstance    identifies the instance of the resource, -1 for single instance resources
+ * \return false if the resource does not fit in the buffer
+ */
+bool LWM2MObjectBuilder::add_int(int resourceID, int value, int resourceInstance)
+{
+   char buff[12];
+   size_t mark = _len;
+   snprintf(buff, sizeof(buff), "%d", value);
+   return end(mark, begin(resourceID, resourceInstance, "v") && append(buff));
+}
+
+//! \brief Adds a float resource
+/*!
+ * \param resourceID          identifies the resource of the object
+ * \param value               value to be set, finite and within the 32 bit integer range
+ * \param resourceInstance    identifies the instance of the resource, -1 for single instance resources
+ * \return false if the value is not valid or the resource does not fit in the buffer
+ */
+bool LWM2MObjectBuilder::add_float(int resourceID, float value, int resourceInstance)
+{
+   char buff[20];
+   if(isnan(value) || isinf(value) || fabs(value) > 4294967040.0)
+   {
+      return false;
+   }
+   size_t mark = _len;
+   ME310::floatToString(value, 6, buff, sizeof(buff));
+   return end(mark, begin(resourceID, resourceInstance, "v") && append(buff));
+}
+
+//! \brief Adds a boolean resource
+/*!
+ * \param resourceID          identifies the resource of the object
+ * \param value               value to be set
+ * \param resourceInstance    identifies the instance of the resource, -1 for single instance resources
+ * \return false if the resource does not fit in the buffer
+ */
+bool LWM2MObjectBuilder::add_bool(int resourceID, bool value, int resourceInstance)
+{
+   size_t mark = _len;
+   return end(mark, begin(resourceID, resourceInstance, "bv") && append(value ? "true" : "false"));
+}
+
+//! \brief Adds a string resource
+/*! \details
+Quotes, backslashes and control characters are escaped.
+ * \param resourceID          identifies the resource of the object
+ * \param value               null terminated value to be set
+ * \param resourceInstance    identifies the instance of the resource, -1 for single instance resources
+ * \return false if the resource does not fit in the buffer
+ */
+bool LWM2MObjectBuilder::add_string(int resourceID, const char *value, int resourceInstance)
+{
+   if(value == NULL)
+   {
+      return false;
+   }
+   size_t mark = _len;
+   return end(mark, begin(resourceID, resourceInstance, "sv") && append("\"") && appendEscaped(value) && append("\""));
+}
+
+//! \brief Adds an opaque resource
+/*! \details
+The value is encoded in base64.
+ * \param resourceID          identifies the resource of the object
+ * \param value               value to be set
+ * \param len                 length of the value in bytes
+ * \param resourceInstance    identifies the instance of the resource, -1 for single instance resources
+ * \return false if the resource does not fit in the buffer
+ */
+bool LWM2MObjectBuilder::add_opaque(int resourceID, const uint8_t *value, size_t len, int resourceInstance)
+{
+   static const char BASE64[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+   if(value == NULL && len > 0)
+   {
+      return false;
+   }
+   size_t mark = _len;
+   bool ok = begin(resourceID, resourceInstance, "sv") && append("\"");
+   for(size_t i = 0; ok && i < len; i += 3)
+   {
+      uint32_t group = (uint32_t)value[i] << 16;
+      if(i + 1 < len)
+      {
+         group |= (uint32_t)value[i + 1] << 8;
+      }
+      if(i + 2 < len)
+      {
+         group |= value[i + 2];
+      }
+      char quad[4];
+      quad[0] = BASE64[(group >> 18) & 0x3F];
+      quad[1] = BASE64[(group >> 12) & 0x3F];
+      quad[2] = (i + 1 < len) ? BASE64[(group >> 6) & 0x3F] : '=';
+      quad[3] = (i + 2 < len) ? BASE64[group & 0x3F] : '=';
+      ok = append(quad, 4);
+   }
+   return end(mark, ok && append("\""));
+}
+
+//! \brief Adds a time resource
+/*!
+ * \param resourceID          identifies the resource of the object
+ * \param value               seconds since Jan 1st, 1970 in the UTC time zone
+ * \param resourceInstance    identifies the instance of the resource, -1 for single instance resources
+ * \return false if the resource does not fit in the buffer
+ */
+bool LWM2MObjectBuilder::add_time(int resourceID, uint32_t value, int resourceInstance)
+{
+   char buff[12];
+   size_t mark = _len;
+   snprintf(buff, sizeof(buff), "%lu", (unsigned long)value);
+   return end(mark, begin(resourceID, resourceInstance, "v") && append(buff));
+}
+
+//! \brief Adds an object link resource
+/*!
+ * \param resourceID          identifies the resource of the object
+ * \param linkObjID           identifies the linked object
+ * \param linkInstanceID      identifies the linked object instance
+ * \param resourceInstance    identifies the instance of the resource, -1 for single instance resources
+ * \return false if the resource does not fit in the buffer
+ */
+bool LWM2MObjectBuilder::add_object_link(int resourceID, int linkObjID, int linkInstanceID, int resourceInstance)
+{
+   char buff[16];
+   size_t mark = _len;
+   snprintf(buff, sizeof(buff), "\"%d:%d\"", linkObjID, linkInstanceID);
+   return end(mark, begin(resourceID, resourceInstance, "ov") && append(buff));
+}
+
+//! \brief Returns the json string
+/*! \details
+The closing brackets are written after the last resource, more resources can still be added.
+ * \return pointer to the null terminated json string
+ */
+const char *LWM2MObjectBuilder::json()
+{
+   memcpy(_buffer + _len, "]}", 3);
+   return _buffer;
+}
+
+//! \brief Sets the resources added with a single AT#LWM2MOBJSET command
+/*!
+ * \param module      module used to send the command
+ * \param agent       identifies the agent LWM2M
+ * \param aTimeout    specifies the timeout
+ * \return return code, RETURN_ERROR without sending the command if no resource was added or a write did not fit
+ */
+ME310::return_t LWM2MObjectBuilder::send(ME310 &module, int agent, ME310::tout_t aTimeout)
+{
+   if(_overflow || _count == 0)
+   {
+      return ME310::RETURN_ERROR;
+   }
+   json();
+   return module.LWM2M_set_object_json(agent, _objID, _instanceID, _buffer, length(), aTimeout);
+}
+
+//! \brief Appends the start of a resource entry, up to the value
+/*!
+ * \param resourceID          identifies the resource of the object
+ * \param resourceInstance    identifies the instance of the resource, -1 for single instance resources
+ * \param key                 value key
+ * \return false if the buffer is full
+ */
+bool LWM2MObjectBuilder::begin(int resourceID, int resourceInstance, const char *key)
+{
+   char buff[40];
+   if(resourceInstance >= 0)
+   {
+      snprintf(buff, sizeof(buff), "%s{\"n\":\"%d/%d\",\"%s\":", (_count > 0) ? "," : "", resourceID, resourceInstance, key);
+   }
+   else
+   {
+      snprintf(buff, sizeof(buff), "%s{\"n\":\"%d\",\"%s\":", (_count > 0) ? "," : "", resourceID, key);
+   }
+   return append(buff);
+}
+
+//! \brief Closes a resource entry
+/*! \details
+If the entry did not fit, the buffer is restored and the builder marked as overflowed.
+ * \param mark    length of the json string before the entry
+ * \param ok      true if the entry was appended up to the value
+ * \return true if the entry has been added
+ */
+bool LWM2MObjectBuilder::end(size_t mark, bool ok)
+{
+   if(!ok || !append("}"))
+   {
+      _len = mark;
+      _overflow = true;
+      return false;
+   }
+   _count++;
+   return true;
+}
+
+//! \brief Appends a string
+/*!
+ * \param str    null terminated string
+ * \return false if the buffer is full
+ */
+bool LWM2MObjectBuilder::append(const char *str)
+{
+   return append(str, strlen(str));
+}
+
+//! \brief Appends characters, keeping room for the closing brackets
+/*!
+ * \param str    characters to append
+ * \param len    number of characters
+ * \return false if the buffer is full
+ */
+bool LWM2MObjectBuilder::append(const char *str, size_t len)
+{
+   if(_len + len + 3 > LWM2M_OBJECT_BUFFSIZE)
+   {
+      return false;
+   }
+   memcpy(_buffer + _len, str, len);
+   _len += len;
+   return true;
+}
+
+//! \brief Appends a string escaping the json special characters
+/*!
+ * \param str    null terminated string
+ * \return false if the buffer is full
+ */
+bool LWM2MObjectBuilder::appendEscaped(const char *str)
+{
+   for(; *str != 0; str++)
+   {
+      char c = *str;
+      bool ok;
+      if(c == '"' || c == '\\')
+      {
+         char escaped[2] = {'\\', c};
+         ok = append(escaped, 2);
+      }
+      else if((uint8_t)c < 0x20)
+      {
+         char escaped[7];
+         snprintf(escaped, sizeof(escaped), "\\u%04x", (uint8_t)c);
+         ok = append(escaped, 6);
+      }
+      else
+      {
+         ok = append(&c, 1);
+      }
+      if(!ok)
+      {
+         return false;
+      }
+   }
+   return true;
+}
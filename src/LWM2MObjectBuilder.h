@@ -0,0 +1,88 @@
+/*Copyright (C) 2026 Telit Communications S.p.A. Italy - All Rights Reserved.*/
+/*    See LICENSE file in the project root for full license information.     */
+
+/**
+  @file
+    LWM2MObjectBuilder.h
+
+  @brief
+    Builder of the AT#LWM2MOBJSET json payload
+
+  @details
+    The class accumulates typed resource writes of an object instance into the LWM2M json format
+    accepted by AT#LWM2MOBJSET, so that a whole instance is updated with a single command.\n
+    The json string is built in a fixed size buffer, no memory is allocated.
+
+  @version
+    2.13.1
+
+  @note
+    Dependencies:
+    ME310.h
+
+  @author
+
+  @date
+    18/10/2026
+*/
+#ifndef __LWM2MOBJECTBUILDER__H
+#define __LWM2MOBJECTBUILDER__H
+
+/* Include files ================================================================================*/
+#include "ME310.h"
+
+namespace me310
+{
+   #define LWM2M_OBJECT_BUFFSIZE 512      ///< Size of the json buffer
+
+   /*! \class LWM2MObjectBuilder
+      \brief Builds and sends the json payload of AT#LWM2MOBJSET
+      \details
+      The payload has the form {"bn":"/obj/inst/","e":[{"n":"res","v":1},{"n":"res/resInst","sv":"text"}]}.
+      Numeric and time values use "v", booleans "bv", strings "sv", opaque values "sv" with base64 content
+      and object links "ov".\n
+      A write that does not fit in the buffer is refused and marks the builder as overflowed: send() then
+      fails without issuing the command, so a partial instance is never written.
+   */
+   class LWM2MObjectBuilder
+   {
+      public:
+
+      LWM2MObjectBuilder(int objID, int instanceID);
+
+      void reset();
+      void reset(int objID, int instanceID);
+
+      bool add_int(int resourceID, int value, int resourceInstance = -1);
+      bool add_float(int resourceID, float value, int resourceInstance = -1);
+      bool add_bool(int resourceID, bool value, int resourceInstance = -1);
+      bool add_string(int resourceID, const char *value, int resourceInstance = -1);
+      bool add_opaque(int resourceID, const uint8_t *value, size_t len, int resourceInstance = -1);
+      bool add_time(int resourceID, uint32_t value, int resourceInstance = -1);
+      bool add_object_link(int resourceID, int linkObjID, int linkInstanceID, int resourceInstance = -1);
+
+      const char *json();
+      size_t length() const { return _len + 2; }     //!< Returns the length of the json string
+      int count() const { return _count; }           //!< Returns the number of resources added
+      bool overflow() const { return _overflow; }    //!< Returns true if a write did not fit in the buffer
+
+      ME310::return_t send(ME310 &module, int agent, ME310::tout_t aTimeout = ME310::TOUT_1SEC);
+
+      private:
+
+      bool begin(int resourceID, int resourceInstance, const char *key);
+      bool end(size_t mark, bool ok);
+      bool append(const char *str);
+      bool append(const char *str, size_t len);
+      bool appendEscaped(const char *str);
+
+      int _objID;                            //!< Object identifier
+      int _instanceID;                       //!< Object instance identifier
+      char _buffer[LWM2M_OBJECT_BUFFSIZE];   //!< Json buffer
+      size_t _len;                           //!< Length of the json string, without the closing brackets
+      int _count;                            //!< Number of resources added
+      bool _overflow;                        //!< True if a write did not fit in the buffer
+   };
+} // end namespace
+
+#endif //__LWM2MOBJECTBUILDER__H
@@ -0,0 +1,559 @@
+/*Copyright (C) 2026 Telit Communications S.p.A. Italy - All Rights Reserved.*/
+/*    See LICENSE file in the project root for full license information.     */
+
+/**
+  @file
+    LWM2MObjectTree.cpp
+
+  @brief
+    Tree of the instances and resources listed by AT#LWM2MOBJGET
+
+  @details
+    The class parses the json listing returned by AT#LWM2MOBJGET in a single pass and builds
+    a tree of object instances and resources in a memory area provided by the caller.\n
+
+  @version
+    2.13.1
+
+  @note
+    Dependencies:
+    LWM2MObjectTree.h
+
+  @author
+
+  @date
+    18/10/2026
+*/
+
+#include "LWM2MObjectTree.h"
+
+using namespace me310;
+
+#define LWM2M_TREE_ALIGN 8          ///< Alignment of the nodes in the arena
+#define LWM2M_TREE_KEY_SIZE 16      ///< Max length of the json keys, longer keys are not accepted
+#define LWM2M_TREE_NAME_SIZE 40     ///< Max length of the "bn" and "n" names
+#define LWM2M_TREE_MAX_DEPTH 4      ///< Object, instance, resource and resource instance
+
+//! \brief Class Constructor
+/*!
+ * \param arena    memory used to store the tree, it must stay valid as long as the tree is used
+ * \param size     size of the arena in bytes
+ */
+LWM2MObjectTree::LWM2MObjectTree(void *arena, size_t size) : _arena((uint8_t*)arena), _size(size)
+{
+   clear();
+}
+
+//! \brief Empties the tree, the whole arena is available again
+void LWM2MObjectTree::clear()
+{
+   _used = 0;
+   _objID = -1;
+   _count = 0;
+   _first = NULL;
+   _last = NULL;
+}
+
+//! \brief Parses an AT#LWM2MOBJGET listing
+/*! \details
+The text can start with the #LWM2MOBJGET: prefix and contain line terminators, the listing
+is parsed from its first '{'. Entries that do not address a resource and unknown keys are skipped.
+The previous content of the tree is discarded.
+ * \param text    null terminated listing
+ * \return false if the listing is not valid json or the arena is too small
+ */
+bool LWM2MObjectTree::parse(const char *text)
+{
+   clear();
+   if(text == NULL)
+   {
+      return false;
+   }
+   const char *p = strstr(text, "#LWM2MOBJGET:");
+   p = strchr(p != NULL ? p : text, '{');
+   if(p == NULL)
+   {
+      return false;
+   }
+
+   int32_t base[LWM2M_TREE_MAX_DEPTH];
+   int baseCount = 0;
+   char key[LWM2M_TREE_KEY_SIZE];
+   size_t len;
+   p = skipSpaces(p + 1);
+   while(*p != '}')
+   {
+      if(*p != '"' || (p = parseString(p, key, sizeof(key), len)) == NULL)
+      {
+         return false;
+      }
+      p = skipSpaces(p);
+      if(*p != ':')
+      {
+         return false;
+      }
+      p = skipSpaces(p + 1);
+      if(strcmp(key, "bn") == 0)
+      {
+         char name[LWM2M_TREE_NAME_SIZE];
+         if(*p != '"' || (p = parseString(p, name, sizeof(name), len)) == NULL)
+         {
+            return false;
+         }
+         baseCount = parsePath(name, base, LWM2M_TREE_MAX_DEPTH);
+      }
+      else if(strcmp(key, "e") == 0)
+      {
+         if(*p != '[')
+         {
+            return false;
+         }
+         p = skipSpaces(p + 1);
+         while(*p != ']')
+         {
+            if(!parseEntry(p, base, baseCount))
+            {
+               return false;
+            }
+            p = skipSpaces(p);
+            if(*p == ',')
+            {
+               p = skipSpaces(p + 1);
+            }
+            else if(*p != ']')
+            {
+               return false;
+            }
+         }
+         p++;
+      }
+      else if((p = skipValue(p)) == NULL)
+      {
+         return false;
+      }
+      p = skipSpaces(p);
+      if(*p == ',')
+      {
+         p = skipSpaces(p + 1);
+      }
+      else if(*p != '}')
+      {
+         return false;
+      }
+   }
+   return true;
+}
+
+//! \brief Returns an object instance
+/*!
+ * \param instanceID    object instance identifier
+ * \return the instance, NULL if it is not in the tree
+ */
+const LWM2MObjectTree::instance_t *LWM2MObjectTree::find(int instanceID) const
+{
+   for(const instance_t *i = _first; i != NULL; i = i->next)
+   {
+      if(i->id == instanceID)
+      {
+         return i;
+      }
+   }
+   return NULL;
+}
+
+//! \brief Returns a resource
+/*!
+ * \param instanceID          object instance identifier
+ * \param resourceID          resource identifier
+ * \param resourceInstance    resource instance identifier, -1 for single instance resources
+ * \return the resource, NULL if it is not in the tree
+ */
+const LWM2MObjectTree::resource_t *LWM2MObjectTree::find(int instanceID, int resourceID, int resourceInstance) const
+{
+   const instance_t *i = find(instanceID);
+   for(const resource_t *r = (i != NULL) ? i->first : NULL; r != NULL; r = r->next)
+   {
+      if(r->id == resourceID && r->instance == resourceInstance)
+      {
+         return r;
+      }
+   }
+   return NULL;
+}
+
+//! \brief Allocates aligned memory from the arena
+/*!
+ * \param size    number of bytes
+ * \return pointer to the memory, NULL if the arena is full
+ */
+void *LWM2MObjectTree::alloc(size_t size)
+{
+   size_t pad = (LWM2M_TREE_ALIGN - ((uintptr_t)(_arena + _used) % LWM2M_TREE_ALIGN)) % LWM2M_TREE_ALIGN;
+   if(_arena == NULL || _used + pad + size > _size)
+   {
+      return NULL;
+   }
+   void *node = _arena + _used + pad;
+   _used += pad + size;
+   return node;
+}
+
+//! \brief Returns an instance of the tree, adding it if needed
+/*! \details
+The listing is grouped by instance, so the last instance is checked first.
+ * \param id    object instance identifier
+ * \return the instance, NULL if the arena is full
+ */
+LWM2MObjectTree::instance_t *LWM2MObjectTree::instance(int32_t id)
+{
+   if(_last != NULL && _last->id == id)
+   {
+      return _last;
+   }
+   instance_t *i = const_cast<instance_t*>(find(id));
+   if(i != NULL)
+   {
+      return i;
+   }
+   i = (instance_t*)alloc(sizeof(instance_t));
+   if(i == NULL)
+   {
+      return NULL;
+   }
+   i->id = id;
+   i->count = 0;
+   i->first = NULL;
+   i->last = NULL;
+   i->next = NULL;
+   if(_last == NULL)
+   {
+      _first = i;
+   }
+   else
+   {
+      _last->next = i;
+   }
+   _last = i;
+   _count++;
+   return i;
+}
+
+//! \brief Parses an entry of the "e" array and adds it to the tree
+/*!
+ * \param p            points to the '{' of the entry, moved after its '}'
+ * \param base         identifiers of the base name
+ * \param baseCount    number of identifiers of the base name
+ * \return false if the entry is not valid json or the arena is too small
+ */
+bool LWM2MObjectTree::parseEntry(const char *&p, const int32_t *base, int baseCount)
+{
+   char key[LWM2M_TREE_KEY_SIZE];
+   char name[LWM2M_TREE_NAME_SIZE] = "";
+   int type = -1;
+   double number = 0;
+   bool boolean = false;
+   const char *string = NULL;
+   size_t len;
+
+   if(*p != '{')
+   {
+      return false;
+   }
+   p = skipSpaces(p + 1);
+   while(*p != '}')
+   {
+      if(*p != '"' || (p = parseString(p, key, sizeof(key), len)) == NULL)
+      {
+         return false;
+      }
+      p = skipSpaces(p);
+      if(*p != ':')
+      {
+         return false;
+      }
+      p = skipSpaces(p + 1);
+      if(strcmp(key, "n") == 0)
+      {
+         if(*p != '"' || (p = parseString(p, name, sizeof(name), len)) == NULL)
+         {
+            return false;
+         }
+      }
+      else if(strcmp(key, "v") == 0)
+      {
+         char *end;
+         number = strtod(p, &end);
+         if(end == p)
+         {
+            return false;
+         }
+         p = end;
+         type = VALUE_NUMBER;
+      }
+      else if(strcmp(key, "bv") == 0)
+      {
+         if(strncmp(p, "true", 4) == 0)
+         {
+            boolean = true;
+         }
+         else if(strncmp(p, "false", 5) != 0)
+         {
+            return false;
+         }
+         p += boolean ? 4 : 5;
+         type = VALUE_BOOLEAN;
+      }
+      else if(strcmp(key, "sv") == 0 || strcmp(key, "ov") == 0)
+      {
+         /* copied straight in the arena, the node is allocated after it */
+         char *dst = (char*)_arena + _used;
+         if(*p != '"' || _arena == NULL || (p = parseString(p, dst, _size - _used, len)) == NULL)
+         {
+            return false;
+         }
+         _used += len + 1;
+         string = dst;
+         type = (key[0] == 's') ? VALUE_STRING : VALUE_OBJLNK;
+      }
+      else if((p = skipValue(p)) == NULL)
+      {
+         return false;
+      }
+      p = skipSpaces(p);
+      if(*p == ',')
+      {
+         p = skipSpaces(p + 1);
+      }
+      else if(*p != '}')
+      {
+         return false;
+      }
+   }
+   p++;
+
+   int32_t ids[LWM2M_TREE_MAX_DEPTH];
+   int count = 0;
+   for(; count < baseCount; count++)
+   {
+      ids[count] = base[count];
+   }
+   count += parsePath(name, ids + count, LWM2M_TREE_MAX_DEPTH - count);
+   if(count < 3 || type < 0)
+   {
+      /* object or instance level entry, nothing to store */
+      return true;
+   }
+   if(_objID < 0)
+   {
+      _objID = ids[0];
+   }
+
+   instance_t *i = instance(ids[1]);
+   resource_t *r = (i != NULL) ? (resource_t*)alloc(sizeof(resource_t)) : NULL;
+   if(r == NULL)
+   {
+      return false;
+   }
+   r->id = ids[2];
+   r->instance = (count > 3) ? ids[3] : -1;
+   r->type = (uint8_t)type;
+   if(type == VALUE_NUMBER)
+   {
+      r->value.number = number;
+   }
+   else if(type == VALUE_BOOLEAN)
+   {
+      r->value.boolean = boolean;
+   }
+   else
+   {
+      r->value.string = string;
+   }
+   r->next = NULL;
+   if(i->last == NULL)
+   {
+      i->first = r;
+   }
+   else
+   {
+      i->last->next = r;
+   }
+   i->last = r;
+   i->count++;
+   return true;
+}
+
+//! \brief Skips white spaces and line terminators
+const char *LWM2MObjectTree::skipSpaces(const char *p)
+{
+   while(*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n')
+   {
+      p++;
+   }
+   return p;
+}
+
+//! \brief Skips a json value
+/*!
+ * \param p    points to the first character of the value
+ * \return pointer after the value, NULL if the value is not terminated
+ */
+const char *LWM2MObjectTree::skipValue(const char *p)
+{
+   int depth = 0;
+   bool quoted = false;
+   for(; *p != 0; p++)
+   {
+      if(quoted)
+      {
+         if(*p == '\\' && p[1] != 0)
+         {
+            p++;
+         }
+         else if(*p == '"')
+         {
+            quoted = false;
+            if(depth == 0)
+            {
+               return p + 1;
+            }
+         }
+      }
+      else if(*p == '"')
+      {
+         quoted = true;
+      }
+      else if(*p == '{' || *p == '[')
+      {
+         depth++;
+      }
+      else if(*p == '}' || *p == ']')
+      {
+         if(depth == 0)
+         {
+            return p;
+         }
+         if(--depth == 0)
+         {
+            return p + 1;
+         }
+      }
+      else if(*p == ',' && depth == 0)
+      {
+         return p;
+      }
+   }
+   return NULL;
+}
+
+//! \brief Converts a path as "/6/0/" or "0/1" in identifiers
+/*!
+ * \param path    path, the parsing stops at the first character that is not a digit or '/'
+ * \param ids     receives the identifiers
+ * \param max     max number of identifiers
+ * \return number of identifiers
+ */
+int LWM2MObjectTree::parsePath(const char *path, int32_t *ids, int max)
+{
+   int count = 0;
+   while(*path != 0 && count < max)
+   {
+      if(*path == '/')
+      {
+         path++;
+      }
+      else if(*path >= '0' && *path <= '9')
+      {
+         int32_t id = 0;
+         while(*path >= '0' && *path <= '9')
+         {
+            id = id * 10 + (*path++ - '0');
+         }
+         ids[count++] = id;
+      }
+      else
+      {
+         break;
+      }
+   }
+   return count;
+}
+
+//! \brief Parses a json string and decodes its escape sequences
+/*! \details
+\\uXXXX sequences are decoded as UTF-8.
+ * \param p       points to the opening quote
+ * \param dst     receives the null terminated string
+ * \param size    size of dst
+ * \param len     receives the length of the string
+ * \return pointer after the closing quote, NULL if the string is not terminated or does not fit dst
+ */
+const char *LWM2MObjectTree::parseString(const char *p, char *dst, size_t size, size_t &len)
+{
+   len = 0;
+   for(p++; *p != '"'; p++)
+   {
+      char c = *p;
+      uint16_t u = 0;
+      bool unicode = false;
+      if(c == 0)
+      {
+         return NULL;
+      }
+      if(c == '\\')
+      {
+         switch(*++p)
+         {
+            case 'n': c = '\n'; break;
+            case 'r': c = '\r'; break;
+            case 't': c = '\t'; break;
+            case 'b': c = '\b'; break;
+            case 'f': c = '\f'; break;
+            case 'u':
+               for(int k = 0; k < 4; k++)
+               {
+                  char h = *++p;
+                  if(h >= '0' && h <= '9') u = (u << 4) | (h - '0');
+                  else if(h >= 'a' && h <= 'f') u = (u << 4) | (h - 'a' + 10);
+                  else if(h >= 'A' && h <= 'F') u = (u << 4) | (h - 'A' + 10);
+                  else return NULL;
+               }
+               unicode = true;
+               break;
+            case 0: return NULL;
+            default: c = *p; break;
+         }
+      }
+      char utf8[3];
+      size_t n = 1;
+      if(!unicode)
+      {
+         utf8[0] = c;
+      }
+      else if(u >= 0x800)
+      {
+         utf8[0] = (char)(0xE0 | (u >> 12));
+         utf8[1] = (char)(0x80 | ((u >> 6) & 0x3F));
+         utf8[2] = (char)(0x80 | (u & 0x3F));
+         n = 3;
+      }
+      else if(u >= 0x80)
+      {
+         utf8[0] = (char)(0xC0 | (u >> 6));
+         utf8[1] = (char)(0x80 | (u & 0x3F));
+         n = 2;
+      }
+      else
+      {
+         utf8[0] = (char)u;
+      }
+      if(len + n >= size)
+      {
+         return NULL;
+      }
+      memcpy(dst + len, utf8, n);
+      len += n;
+   }
+   dst[len] = 0;
+   return p + 1;
+}
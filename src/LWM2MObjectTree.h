@@ -0,0 +1,118 @@
+/*Copyright (C) 2026 Telit Communications S.p.A. Italy - All Rights Reserved.*/
+/*    See LICENSE file in the project root for full license information.     */
+
+/**
+  @file
+    LWM2MObjectTree.h
+
+  @brief
+    Tree of the instances and resources listed by AT#LWM2MOBJGET
+
+  @details
+    The class parses the json listing returned by AT#LWM2MOBJGET in a single pass and builds
+    a tree of object instances and resources in a memory area provided by the caller.\n
+    No memory is allocated from the heap.
+
+  @version
+    2.13.1
+
+  @note
+    Dependencies:
+    ME310.h
+
+  @author
+
+  @date
+    18/10/2026
+*/
+#ifndef __LWM2MOBJECTTREE__H
+#define __LWM2MOBJECTTREE__H
+
+/* Include files ================================================================================*/
+#include "ME310.h"
+
+namespace me310
+{
+   /*! \class LWM2MObjectTree
+      \brief Instances and resources of an LWM2M object
+      \details
+      The listing has the form {"bn":"/obj/","e":[{"n":"inst/res","v":1},{"n":"inst/res/resInst","sv":"text"}]}:
+      each entry name is appended to the base name to obtain the resource URI. Numeric values ("v") are stored
+      as double, booleans ("bv") as bool, strings ("sv") and object links ("ov") are copied in the arena.\n
+      Nodes are appended to the arena in listing order, so the tree stays valid as long as the arena does,
+      regardless of the driver buffer. parse() fails when the arena is too small and the tree is then partial.
+   */
+   class LWM2MObjectTree
+   {
+      public:
+
+      typedef enum
+      {
+         VALUE_NUMBER = 0,
+         VALUE_BOOLEAN,
+         VALUE_STRING,
+         VALUE_OBJLNK
+      } value_type_t;
+
+      /*! \struct resource_t
+         \brief Resource value
+      */
+      typedef struct resource_s
+      {
+         int32_t id;                      ///< Resource identifier
+         int32_t instance;                ///< Resource instance identifier, -1 for single instance resources
+         uint8_t type;                    ///< Value type, see value_type_t
+         union
+         {
+            double number;                ///< VALUE_NUMBER value
+            bool boolean;                 ///< VALUE_BOOLEAN value
+            const char *string;           ///< VALUE_STRING and VALUE_OBJLNK value
+         } value;                         ///< Resource value
+         const struct resource_s *next;   ///< Next resource of the instance
+      } resource_t;
+
+      /*! \struct instance_t
+         \brief Object instance
+      */
+      typedef struct instance_s
+      {
+         int32_t id;                      ///< Object instance identifier
+         int count;                       ///< Number of resources
+         const resource_t *first;         ///< First resource
+         resource_t *last;                ///< Last resource, used while parsing
+         const struct instance_s *next;   ///< Next instance of the object
+      } instance_t;
+
+      LWM2MObjectTree(void *arena, size_t size);
+
+      bool parse(const char *text);
+      void clear();
+
+      int object() const { return _objID; }                       //!< Returns the object identifier, -1 if not parsed
+      int count() const { return _count; }                        //!< Returns the number of instances
+      const instance_t *instances() const { return _first; }      //!< Returns the first instance
+      const instance_t *find(int instanceID) const;
+      const resource_t *find(int instanceID, int resourceID, int resourceInstance = -1) const;
+      size_t used() const { return _used; }                       //!< Returns the number of arena bytes used
+
+      private:
+
+      void *alloc(size_t size);
+      instance_t *instance(int32_t id);
+      bool parseEntry(const char *&p, const int32_t *base, int baseCount);
+      static const char *skipSpaces(const char *p);
+      static const char *skipValue(const char *p);
+      static int parsePath(const char *path, int32_t *ids, int max);
+      const char *parseString(const char *p, char *dst, size_t size, size_t &len);
+
+      uint8_t *_arena;                 //!< Memory provided by the caller
+      size_t _size;                    //!< Size of the arena
+      size_t _used;                    //!< Used size of the arena
+      int32_t _objID;                  //!< Object identifier
+      int _count;                      //!< Number of instances
+      const instance_t *_first;        //!< First instance
+      instance_t *_last;               //!< Last instance
+   };
+} // end namespace
+
+#endif //__LWM2MOBJECTTREE__H
@@ -0,0 +1,405 @@
+/*Copyright (C) 2026 Telit Communications S.p.A. Italy - All Rights Reserved.*/
+/*    See LICENSE file in the project root for full license information.     */
+
+/**
+  @file
+    LWM2MShadow.cpp
+
+  @brief
+    Local shadow of the LWM2M resources set by the application
+
+  @details
+    The class keeps the last value written to each resource through AT#LWM2MSET and skips
+    the writes that do not change the value, or change it less than a deadband.\n
+
+  @version
+    2.13.1
+
+  @note
+    Dependencies:
+    LWM2MShadow.h
+
+  @author
+
+  @date
+    18/10/2026
+*/
+
+#include "LWM2MShadow.h"
+#include <string.h>
+#include <math.h>
+
+using namespace me310;
+
+//! \brief Class Constructor
+/*!
+ * \param module      module used to set the resources
+ * \param deadband    deadband of the int, time and float resources
+ */
+LWM2MShadow::LWM2MShadow(ME310 &module, float deadband) : _module(module), _deadband(deadband), _pool(NULL), _slotSize(0), _count(0)
+{
+   memset(_entries, 0, sizeof(_entries));
+   reset_statistics();
+}
+
+//! \brief Sets the deadband of a resource
+/*!
+ * \param objID               identifies the object LWM2M
+ * \param instanceID          identifies the instance of the object
+ * \param resourceID          identifies the resource of the object
+ * \param resourceInstance    identifies the instance of the resource
+ * \param deadband            max change of the value that does not trigger a write
+ * \return false if the shadow is full
+ */
+bool LWM2MShadow::set_deadband(int objID, int instanceID, int resourceID, int resourceInstance, float deadband)
+{
+   entry_t *entry = find(makeKey(objID, instanceID, resourceID, resourceInstance), true);
+   if(entry == NULL)
+   {
+      return false;
+   }
+   entry->hasDeadband = true;
+   entry->deadband = deadband;
+   return true;
+}
+
+//! \brief Keeps a copy of the written strings
+/*! \details
+The strings are then compared byte by byte instead of by hash. Each resource uses a slot; strings that do not
+fit a slot, terminator included, are always written. The strings already in the shadow are written again.
+ * \param pool        buffer of LWM2M_SHADOW_SIZE * slotSize bytes, NULL to go back to the hash comparison
+ * \param slotSize    size of a slot
+ */
+void LWM2MShadow::set_string_pool(char *pool, size_t slotSize)
+{
+   _pool = (slotSize > 0) ? pool : NULL;
+   _slotSize = (_pool != NULL) ? slotSize : 0;
+   for(int i = 0; i < _count; i++)
+   {
+      if(_entries[i].type == TYPE_STRING)
+      {
+         _entries[i].type = TYPE_NONE;
+      }
+   }
+}
+
+//! \brief Sets an integer resource, if changed
+/*!
+ * \param objID               identifies the object LWM2M
+ * \param instanceID          identifies the instance of the object
+ * \param resourceID          identifies the resource of the object
+ * \param resourceInstance    identifies the instance of the resource
+ * \param value               value to be set
+ * \param aTimeout            specifies the timeout
+ * \return return code, RETURN_VALID if the write was skipped
+ */
+ME310::return_t LWM2MShadow::set_resource_int(int objID, int instanceID, int resourceID, int resourceInstance, int value, ME310::tout_t aTimeout)
+{
+   entry_t *entry = find(makeKey(objID, instanceID, resourceID, resourceInstance), true);
+   if(entry != NULL && unchanged(entry, TYPE_INT, (float)((double)value - entry->value.i)))
+   {
+      return ME310::RETURN_VALID;
+   }
+   ME310::return_t ret = _module.LWM2M_set_resource_int(objID, instanceID, resourceID, resourceInstance, value, aTimeout);
+   if(update(entry, TYPE_INT, ret))
+   {
+      entry->value.i = value;
+   }
+   return ret;
+}
+
+//! \brief Sets a float resource, if changed
+/*!
+ * \param objID               identifies the object LWM2M
+ * \param instanceID          identifies the instance of the object
+ * \param resourceID          identifies the resource of the object
+ * \param resourceInstance    identifies the instance of the resource
+ * \param value               value to be set
+ * \param aTimeout            specifies the timeout
+ * \return return code, RETURN_VALID if the write was skipped
+ */
+ME310::return_t LWM2MShadow::set_resource_float(int objID, int instanceID, int resourceID, int resourceInstance, float value, ME310::tout_t aTimeout)
+{
+   entry_t *entry = find(makeKey(objID, instanceID, resourceID, resourceInstance), true);
+   /* a non-finite value has no meaningful delta, it is always written and so is the next value */
+   if(entry != NULL && isfinite(value) && (entry->type != TYPE_FLOAT || isfinite(entry->value.f)) &&
+      unchanged(entry, TYPE_FLOAT, value - entry->value.f))
+   {
+      return ME310::RETURN_VALID;
+   }
+   ME310::return_t ret = _module.LWM2M_set_resource_float(objID, instanceID, resourceID, resourceInstance, value, aTimeout);
+   if(update(entry, TYPE_FLOAT, ret))
+   {
+      entry->value.f = value;
+   }
+   return ret;
+}
+
+//! \brief Sets a boolean resource, if changed
+/*!
+ * \param objID               identifies the object LWM2M
+ * \param instanceID          identifies the instance of the object
+ * \param resourceID          identifies the resource of the object
+ * \param resourceInstance    identifies the instance of the resource
+ * \param value               value to be set
+ * \param aTimeout            specifies the timeout
+ * \return return code, RETURN_VALID if the write was skipped
+ */
+ME310::return_t LWM2MShadow::set_resource_bool(int objID, int instanceID, int resourceID, int resourceInstance, int value, ME310::tout_t aTimeout)
+{
+   entry_t *entry = find(makeKey(objID, instanceID, resourceID, resourceInstance), true);
+   if(entry != NULL && entry->type == TYPE_BOOL && entry->value.i == value)
+   {
+      _stats.hits++;
+      return ME310::RETURN_VALID;
+   }
+   ME310::return_t ret = _module.LWM2M_set_resource_bool(objID, instanceID, resourceID, resourceInstance, value, aTimeout);
+   if(update(entry, TYPE_BOOL, ret))
+   {
+      entry->value.i = value;
+   }
+   return ret;
+}
+
+//! \brief Sets a string resource, if changed
+/*!
+ * \param objID               identifies the object LWM2M
+ * \param instanceID          identifies the instance of the object
+ * \param resourceID          identifies the resource of the object
+ * \param resourceInstance    identifies the instance of the resource
+ * \param value               value to be set
+ * \param aTimeout            specifies the timeout
+ * \return return code, RETURN_VALID if the write was skipped
+ */
+ME310::return_t LWM2MShadow::set_resource_string(int objID, int instanceID, int resourceID, int resourceInstance, char *value, ME310::tout_t aTimeout)
+{
+   uint32_t len;
+   uint32_t h = hash(value, len);
+   entry_t *entry = find(makeKey(objID, instanceID, resourceID, resourceInstance), true);
+   if(entry != NULL && string_unchanged(entry, value, h, len))
+   {
+      _stats.hits++;
+      return ME310::RETURN_VALID;
+   }
+   ME310::return_t ret = _module.LWM2M_set_resource_string(objID, instanceID, resourceID, resourceInstance, value, aTimeout);
+   if(update(entry, TYPE_STRING, ret))
+   {
+      entry->value.s.hash = h;
+      entry->value.s.len = len;
+      if(_pool != NULL && len < _slotSize && value != NULL)
+      {
+         memcpy(_pool + entry->slot * _slotSize, value, len + 1);
+      }
+   }
+   return ret;
+}
+
+//! \brief Sets a time resource, if changed
+/*!
+ * \param objID               identifies the object LWM2M
+ * \param instanceID          identifies the instance of the object
+ * \param resourceID          identifies the resource of the object
+ * \param resourceInstance    identifies the instance of the resource
+ * \param value               seconds since Jan 1st, 1970 in the UTC time zone
+ * \param aTimeout            specifies the timeout
+ * \return return code, RETURN_VALID if the write was skipped
+ */
+ME310::return_t LWM2MShadow::set_resource_time(int objID, int instanceID, int resourceID, int resourceInstance, int value, ME310::tout_t aTimeout)
+{
+   entry_t *entry = find(makeKey(objID, instanceID, resourceID, resourceInstance), true);
+   if(entry != NULL && unchanged(entry, TYPE_TIME, (float)((double)value - entry->value.i)))
+   {
+      return ME310::RETURN_VALID;
+   }
+   ME310::return_t ret = _module.LWM2M_set_resource_time(objID, instanceID, resourceID, resourceInstance, value, aTimeout);
+   if(update(entry, TYPE_TIME, ret))
+   {
+      entry->value.i = value;
+   }
+   return ret;
+}
+
+//! \brief Forgets all the written values
+/*! \details
+The next write of each resource is sent to the module. Deadbands are kept.
+ */
+void LWM2MShadow::invalidate()
+{
+   for(int i = 0; i < _count; i++)
+   {
+      _entries[i].type = TYPE_NONE;
+   }
+}
+
+//! \brief Forgets the written value of a resource
+/*!
+ * \param objID               identifies the object LWM2M
+ * \param instanceID          identifies the instance of the object
+ * \param resourceID          identifies the resource of the object
+ * \param resourceInstance    identifies the instance of the resource
+ */
+void LWM2MShadow::invalidate(int objID, int instanceID, int resourceID, int resourceInstance)
+{
+   entry_t *entry = find(makeKey(objID, instanceID, resourceID, resourceInstance), false);
+   if(entry != NULL)
+   {
+      entry->type = TYPE_NONE;
+   }
+}
+
+//! \brief Returns the ratio of the skipped writes
+/*!
+ * \return hits / (hits + misses), 0 if no write was requested
+ */
+float LWM2MShadow::hit_rate() const
+{
+   uint32_t total = _stats.hits + _stats.misses;
+   if(total == 0)
+   {
+      return 0;
+   }
+   return (float)_stats.hits / total;
+}
+
+//! \brief Packs a resource URI in a sortable key
+/*!
+ * \return key
+ */
+uint64_t LWM2MShadow::makeKey(int objID, int instanceID, int resourceID, int resourceInstance)
+{
+   return ((uint64_t)(uint16_t)objID << 48) | ((uint64_t)(uint16_t)instanceID << 32) |
+          ((uint64_t)(uint16_t)resourceID << 16) | (uint16_t)resourceInstance;
+}
+
+//! \brief Computes the FNV-1a hash of a string
+/*!
+ * \param value    null terminated string
+ * \param len      filled with the string length
+ * \return hash
+ */
+uint32_t LWM2MShadow::hash(const char *value, uint32_t &len)
+{
+   uint32_t h = 2166136261UL;
+   len = 0;
+   if(value == NULL)
+   {
+      return h;
+   }
+   for(; value[len] != 0; len++)
+   {
+      h ^= (uint8_t)value[len];
+      h *= 16777619UL;
+   }
+   return h;
+}
+
+//! \brief Searches the entry of a resource with a binary search
+/*!
+ * \param key       packed resource URI
+ * \param create    if true a new entry is inserted when not found
+ * \return pointer to the entry, NULL if not found or the shadow is full
+ */
+LWM2MShadow::entry_t *LWM2MShadow::find(uint64_t key, bool create)
+{
+   int low = 0;
+   int high = _count;
+   while(low < high)
+   {
+      int mid = (low + high) / 2;
+      if(_entries[mid].key < key)
+      {
+         low = mid + 1;
+      }
+      else
+      {
+         high = mid;
+      }
+   }
+   if(low < _count && _entries[low].key == key)
+   {
+      return &_entries[low];
+   }
+   if(!create || _count >= LWM2M_SHADOW_SIZE)
+   {
+      return NULL;
+   }
+   memmove(&_entries[low + 1], &_entries[low], (_count - low) * sizeof(entry_t));
+   memset(&_entries[low], 0, sizeof(entry_t));
+   _entries[low].key = key;
+   _entries[low].slot = (uint8_t)_count;
+   _count++;
+   return &_entries[low];
+}
+
+//! \brief Checks if a numeric value is within the deadband of the written one
+/*! \details
+Counts a hit when it is.
+ * \param entry    resource entry
+ * \param type     type of the value
+ * \param delta    difference between the value and the written one
+ * \return true if the write can be skipped
+ */
+bool LWM2MShadow::unchanged(const entry_t *entry, type_t type, float delta)
+{
+   if(entry->type != type)
+   {
+      return false;
+   }
+   float deadband = entry->hasDeadband ? entry->deadband : _deadband;
+   if(!(fabs(delta) <= deadband))
+   {
+      /* also a NaN delta */
+      return false;
+   }
+   _stats.hits++;
+   return true;
+}
+
+//! \brief Checks if a string is equal to the written one
+/*!
+ * \param entry    resource entry
+ * \param value    string to be written
+ * \param h        hash of the string
+ * \param len      length of the string
+ * \return true if the write can be skipped
+ */
+bool LWM2MShadow::string_unchanged(const entry_t *entry, const char *value, uint32_t h, uint32_t len) const
+{
+   if(entry->type != TYPE_STRING || entry->value.s.hash != h || entry->value.s.len != len)
+   {
+      return false;
+   }
+   if(_pool == NULL)
+   {
+      return true;
+   }
+   /* strings that do not fit a slot are not stored */
+   return len < _slotSize && (len == 0 || memcmp(_pool + entry->slot * _slotSize, value, len) == 0);
+}
+
+//! \brief Updates the statistics and the entry type after a write
+/*!
+ * \param entry    resource entry, NULL if the shadow is full
+ * \param type     type of the written value
+ * \param ret      return code of the write
+ * \return true if the caller has to store the written value in the entry
+ */
+bool LWM2MShadow::update(entry_t *entry, type_t type, ME310::return_t ret)
+{
+   _stats.misses++;
+   if(ret != ME310::RETURN_VALID)
+   {
+      _stats.errors++;
+      if(entry != NULL)
+      {
+         entry->type = TYPE_NONE;
+      }
+      return false;
+   }
+   if(entry == NULL)
+   {
+      return false;
+   }
+   entry->type = type;
+   return true;
+}
@@ -0,0 +1,133 @@
+/*Copyright (C) 2026 Telit Communications S.p.A. Italy - All Rights Reserved.*/
+/*    See LICENSE file in the project root for full license information.     */
+
+/**
+  @file
+    LWM2MShadow.h
+
+  @brief
+    Local shadow of the LWM2M resources set by the application
+
+  @details
+    The class keeps the last value written to each resource through AT#LWM2MSET and skips
+    the writes that do not change the value, or change it less than a deadband.\n
+    Entries are stored in a fixed size array sorted by URI, no memory is allocated.
+
+  @version
+    2.13.1
+
+  @note
+    Dependencies:
+    ME310.h
+
+  @author
+
+  @date
+    18/10/2026
+*/
+#ifndef __LWM2MSHADOW__H
+#define __LWM2MSHADOW__H
+
+/* Include files ================================================================================*/
+#include "ME310.h"
+
+namespace me310
+{
+   #define LWM2M_SHADOW_SIZE 64      ///< Max number of resources in the shadow
+
+   /*! \class LWM2MShadow
+      \brief Skips redundant LWM2M resource writes
+      \details
+      The set_resource_* methods mirror ME310::LWM2M_set_resource_*. A write is sent to the module only if
+      the resource is not in the shadow yet, its type changed, or its value differs from the last written one
+      by more than the deadband (int, time and float values) or at all (bool and string values). Float values
+      that are not finite (NaN, infinity) are always written, and so is any value after one of them. The shadow
+      is updated only when the module accepts the write.\n
+      By default strings are compared by a 32 bit FNV-1a hash and their length, so the shadow does not store
+      them and a hash collision skips a real change. set_string_pool() gives the shadow a buffer where the
+      strings are copied and compared byte by byte; strings longer than a slot are then always written.\n
+      When the shadow is full the writes of new resources are sent without being cached.
+   */
+   class LWM2MShadow
+   {
+      public:
+
+      /*! \struct stats_t
+         \brief Shadow statistics
+      */
+      typedef struct
+      {
+         uint32_t hits;       ///< Writes skipped because the value did not change
+         uint32_t misses;     ///< Writes sent to the module
+         uint32_t errors;     ///< Writes refused by the module
+      } stats_t;
+
+      LWM2MShadow(ME310 &module, float deadband = 0);
+
+      void set_deadband(float deadband) { _deadband = deadband; }   //!< Sets the deadband of the resources without a specific one
+      void set_string_pool(char *pool, size_t slotSize);
+      bool set_deadband(int objID, int instanceID, int resourceID, int resourceInstance, float deadband);
+
+      ME310::return_t set_resource_int(int objID, int instanceID, int resourceID, int resourceInstance, int value, ME310::tout_t aTimeout = ME310::TOUT_100MS);
+      ME310::return_t set_resource_float(int objID, int instanceID, int resourceID, int resourceInstance, float value, ME310::tout_t aTimeout = ME310::TOUT_100MS);
+      ME310::return_t set_resource_bool(int objID, int instanceID, int resourceID, int resourceInstance, int value, ME310::tout_t aTimeout = ME310::TOUT_100MS);
+      ME310::return_t set_resource_string(int objID, int instanceID, int resourceID, int resourceInstance, char *value, ME310::tout_t aTimeout = ME310::TOUT_100MS);
+      ME310::return_t set_resource_time(int objID, int instanceID, int resourceID, int resourceInstance, int value, ME310::tout_t aTimeout = ME310::TOUT_100MS);
+
+      void invalidate();
+      void invalidate(int objID, int instanceID, int resourceID, int resourceInstance);
+
+      int size() const { return _count; }                          //!< Returns the number of resources in the shadow
+      const stats_t &statistics() const { return _stats; }         //!< Returns the shadow statistics
+      void reset_statistics() { memset(&_stats, 0, sizeof(_stats)); }   //!< Resets the shadow statistics
+      float hit_rate() const;
+
+      private:
+
+      typedef enum
+      {
+         TYPE_NONE = 0,
+         TYPE_INT,
+         TYPE_FLOAT,
+         TYPE_BOOL,
+         TYPE_STRING,
+         TYPE_TIME
+      } type_t;
+
+      typedef struct
+      {
+         uint64_t key;          //!< Packed URI, see makeKey()
+         uint8_t type;          //!< Type of the last written value, TYPE_NONE if not valid
+         bool hasDeadband;      //!< True if deadband overrides the shadow one
+         uint8_t slot;          //!< Slot of the string in the pool, in creation order
+         float deadband;        //!< Deadband of the resource
+         union
+         {
+            int32_t i;          //!< int, bool and time value
+            float f;            //!< float value
+            struct
+            {
+               uint32_t hash;   //!< string hash
+               uint32_t len;    //!< string length
+            } s;
+         } value;               //!< Last written value
+      } entry_t;
+
+      static uint64_t makeKey(int objID, int instanceID, int resourceID, int resourceInstance);
+      static uint32_t hash(const char *value, uint32_t &len);
+      entry_t *find(uint64_t key, bool create);
+      bool unchanged(const entry_t *entry, type_t type, float delta);
+      bool string_unchanged(const entry_t *entry, const char *value, uint32_t h, uint32_t len) const;
+      bool update(entry_t *entry, type_t type, ME310::return_t ret);
+
+      ME310 &_module;                        //!< Module used to set the resources
+      float _deadband;                       //!< Deadband of the resources without a specific one
+      char *_pool;                           //!< Copies of the strings, LWM2M_SHADOW_SIZE slots, NULL to compare hashes
+      size_t _slotSize;                      //!< Size of a slot of the pool
+      entry_t _entries[LWM2M_SHADOW_SIZE];   //!< Entries sorted by key
+      int _count;                            //!< Number of used entries
+      stats_t _stats;                        //!< Shadow statistics
+   };
+} // end namespace
+
+#endif //__LWM2MSHADOW__H
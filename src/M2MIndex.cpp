@@ -0,0 +1,319 @@
+/*Copyright (C) 2026 Telit Communications S.p.A. Italy - All Rights Reserved.*/
+/*    See LICENSE file in the project root for full license information.     */
+
+/**
+  @file
+    M2MIndex.cpp
+
+  @brief
+    Cached index of the M2M file system directories
+
+  @details
+    The class keeps the entries listed by AT#M2MLIST for a few directories, sorted by name,
+    so that size and existence queries are answered with a binary search instead of an AT command.\n
+
+  @version
+    2.13.1
+
+  @note
+    Dependencies:
+    M2MIndex.h
+
+  @author
+
+  @date
+    18/10/2026
+*/
+
+#include "M2MIndex.h"
+
+using namespace me310;
+
+//! \brief Class Constructor
+M2MIndex::M2MIndex()
+{
+   clear();
+}
+
+//! \brief Drops all the directories
+void M2MIndex::clear()
+{
+   _dirCount = 0;
+   _entryCount = 0;
+   _building = -1;
+   _clock = 0;
+}
+
+//! \brief Starts the indexing of a directory
+/*! \details
+The previous entries of the directory are dropped. If all the directories are used, the least
+recently used one is dropped.
+ * \param path    directory path, "." for the current directory
+ */
+void M2MIndex::begin(const char *path)
+{
+   if(_building >= 0)
+   {
+      end();
+   }
+   drop(path);
+   if(_dirCount == M2M_INDEX_MAX_DIRS)
+   {
+      int oldest = 0;
+      for(int i = 1; i < _dirCount; i++)
+      {
+         if(_dirs[i].used < _dirs[oldest].used)
+         {
+            oldest = i;
+         }
+      }
+      remove(oldest);
+   }
+   dir_t &dir = _dirs[_dirCount];
+   normalize(path, dir.path, sizeof(dir.path));
+   dir.first = _entryCount;
+   dir.count = 0;
+   dir.used = ++_clock;
+   dir.complete = true;
+   _building = _dirCount++;
+}
+
+//! \brief Adds an entry to the directory started with begin()
+/*! \details
+If the pool is full the least recently used directories are dropped to make room.
+ * \param name    entry name, without path
+ * \param size    file size, -1 for directories
+ * \return false if the entry does not fit, the directory is then incomplete
+ */
+bool M2MIndex::add(const char *name, int size)
+{
+   if(_building < 0)
+   {
+      return false;
+   }
+   if(name == NULL || strlen(name) >= M2M_INDEX_NAME_SIZE)
+   {
+      _dirs[_building].complete = false;
+      return false;
+   }
+   while(_entryCount == M2M_INDEX_MAX_ENTRIES)
+   {
+      int oldest = -1;
+      for(int i = 0; i < _dirCount; i++)
+      {
+         if(i != _building && (oldest < 0 || _dirs[i].used < _dirs[oldest].used))
+         {
+            oldest = i;
+         }
+      }
+      if(oldest < 0)
+      {
+         _dirs[_building].complete = false;
+         return false;
+      }
+      remove(oldest);
+   }
+   entry_t &entry = _entries[_entryCount++];
+   strcpy(entry.name, name);
+   entry.size = size;
+   _dirs[_building].count++;
+   return true;
+}
+
+//! \brief Ends the indexing of a directory and sorts its entries
+void M2MIndex::end()
+{
+   if(_building < 0)
+   {
+      return;
+   }
+   dir_t &dir = _dirs[_building];
+   entry_t *entries = _entries + dir.first;
+   for(int i = 1; i < dir.count; i++)
+   {
+      entry_t entry = entries[i];
+      int j = i;
+      for(; j > 0 && strcmp(entries[j-1].name, entry.name) > 0; j--)
+      {
+         entries[j] = entries[j-1];
+      }
+      entries[j] = entry;
+   }
+   _building = -1;
+}
+
+//! \brief Looks up a file or directory
+/*!
+ * \param file_name    file name, with path
+ * \param size    receives the file size, -1 for directories
+ * \return M2M_INDEX_UNKNOWN if the directory of the file is not indexed or is incomplete
+ */
+M2MIndex::lookup_t M2MIndex::find(const char *file_name, int &size)
+{
+   char path[ME310_M2M_NAME_SIZE];
+   const char *name = split(file_name, path, sizeof(path));
+   size = -1;
+   int index = lookup(path);
+   if(index < 0 || !_dirs[index].complete)
+   {
+      return M2M_INDEX_UNKNOWN;
+   }
+   dir_t &dir = _dirs[index];
+   dir.used = ++_clock;
+   int low = dir.first;
+   int high = dir.first + dir.count - 1;
+   while(low <= high)
+   {
+      int mid = (low + high) / 2;
+      int cmp = strcmp(_entries[mid].name, name);
+      if(cmp == 0)
+      {
+         size = _entries[mid].size;
+         return M2M_INDEX_FOUND;
+      }
+      if(cmp < 0)
+      {
+         low = mid + 1;
+      }
+      else
+      {
+         high = mid - 1;
+      }
+   }
+   return M2M_INDEX_MISSING;
+}
+
+//! \brief Returns the sorted entries of a directory
+/*!
+ * \param path    directory path
+ * \param count    receives the number of entries
+ * \return first entry, NULL if the directory is not indexed or is incomplete
+ */
+const M2MIndex::entry_t *M2MIndex::entries(const char *path, int &count)
+{
+   count = 0;
+   int index = lookup(path);
+   if(index < 0 || !_dirs[index].complete)
+   {
+      return NULL;
+   }
+   _dirs[index].used = ++_clock;
+   count = _dirs[index].count;
+   return _entries + _dirs[index].first;
+}
+
+//! \brief Drops the directory containing a file
+/*!
+ * \param file_name    file or directory name, with path
+ */
+void M2MIndex::invalidate(const char *file_name)
+{
+   char path[ME310_M2M_NAME_SIZE];
+   split(file_name, path, sizeof(path));
+   drop(path);
+}
+
+//! \brief Drops a directory
+/*!
+ * \param path    directory path
+ */
+void M2MIndex::drop(const char *path)
+{
+   int index = lookup(path);
+   if(index >= 0)
+   {
+      remove(index);
+   }
+}
+
+//! \brief Splits a file name in directory path and name
+/*!
+ * \param file_name    file name, with path
+ * \param path    receives the directory path, "." if file_name has no path
+ * \param size    size of path
+ * \return the name part of file_name
+ */
+const char *M2MIndex::split(const char *file_name, char *path, size_t size)
+{
+   const char *slash = strrchr(file_name, '/');
+   if(slash == NULL)
+   {
+      snprintf(path, size, "%s", ".");
+      return file_name;
+   }
+   size_t len = (slash == file_name) ? 1 : (size_t)(slash - file_name);
+   if(len >= size)
+   {
+      len = size - 1;
+   }
+   memcpy(path, file_name, len);
+   path[len] = 0;
+   return slash + 1;
+}
+
+//! \brief Returns the index of a directory
+/*!
+ * \param path    directory path
+ * \return index in _dirs, -1 if not indexed
+ */
+int M2MIndex::lookup(const char *path)
+{
+   char normalized[ME310_M2M_NAME_SIZE];
+   normalize(path, normalized, sizeof(normalized));
+   for(int i = 0; i < _dirCount; i++)
+   {
+      if(strcmp(_dirs[i].path, normalized) == 0)
+      {
+         return i;
+      }
+   }
+   return -1;
+}
+
+//! \brief Removes a directory and compacts the pool
+/*!
+ * \param index    index in _dirs
+ */
+void M2MIndex::remove(int index)
+{
+   int first = _dirs[index].first;
+   int count = _dirs[index].count;
+   memmove(_entries + first, _entries + first + count, (_entryCount - first - count) * sizeof(entry_t));
+   _entryCount -= count;
+   for(int i = 0; i < _dirCount; i++)
+   {
+      if(_dirs[i].first > first)
+      {
+         _dirs[i].first -= count;
+      }
+   }
+   for(int i = index; i < _dirCount - 1; i++)
+   {
+      _dirs[i] = _dirs[i+1];
+   }
+   _dirCount--;
+   if(_building == index)
+   {
+      _building = -1;
+   }
+   else if(_building > index)
+   {
+      _building--;
+   }
+}
+
+//! \brief Removes the trailing '/' from a directory path
+/*!
+ * \param path    directory path, empty for the current directory
+ * \param dst     receives the normalized path
+ * \param size    size of dst
+ */
+void M2MIndex::normalize(const char *path, char *dst, size_t size)
+{
+   snprintf(dst, size, "%s", (path == NULL || *path == 0) ? "." : path);
+   size_t len = strlen(dst);
+   while(len > 1 && dst[len-1] == '/')
+   {
+      dst[--len] = 0;
+   }
+}
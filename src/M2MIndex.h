@@ -0,0 +1,112 @@
+/*Copyright (C) 2026 Telit Communications S.p.A. Italy - All Rights Reserved.*/
+/*    See LICENSE file in the project root for full license information.     */
+
+/**
+  @file
+    M2MIndex.h
+
+  @brief
+    Cached index of the M2M file system directories
+
+  @details
+    The class keeps the entries listed by AT#M2MLIST for a few directories, sorted by name,
+    so that size and existence queries are answered with a binary search instead of an AT command.\n
+    Entries are stored in a fixed size pool, no memory is allocated.
+
+  @version
+    2.13.1
+
+  @note
+    Dependencies:
+    ME310.h
+
+  @author
+
+  @date
+    18/10/2026
+*/
+#ifndef __M2MINDEX__H
+#define __M2MINDEX__H
+
+/* Include files ================================================================================*/
+#include "ME310.h"
+
+namespace me310
+{
+   #define M2M_INDEX_MAX_DIRS 4          ///< Max number of cached directories
+   #define M2M_INDEX_MAX_ENTRIES 48      ///< Max number of cached entries, shared by the directories
+   #define M2M_INDEX_NAME_SIZE 32        ///< Max length of an entry name, including terminator
+
+   /*! \class M2MIndex
+      \brief Sorted index of the M2M file system directories
+      \details
+      A directory is indexed by begin(), add() for each entry of its listing and end(). When the pool is full the
+      least recently used directories are dropped; if the listing still does not fit, the directory is kept as
+      incomplete and its lookups report M2M_INDEX_UNKNOWN.\n
+      The index can be attached to the driver with ME310::m2m_set_index(): m2m_file_size() and m2m_file_exists()
+      then list each directory once, and the directories are invalidated by the driver file system commands
+      (write, delete, mkdir, rmdir, chdir). Changes made by AppZone applications are not seen: call clear() or
+      invalidate() after running them.
+   */
+   class M2MIndex
+   {
+      public:
+
+      typedef enum
+      {
+         M2M_INDEX_UNKNOWN = 0,     ///< Directory not indexed, the module must be queried
+         M2M_INDEX_MISSING,         ///< Directory indexed, the entry does not exist
+         M2M_INDEX_FOUND            ///< Entry found
+      } lookup_t;
+
+      /*! \struct entry_t
+         \brief Entry of a directory
+      */
+      typedef struct
+      {
+         char name[M2M_INDEX_NAME_SIZE];  ///< Entry name, without path
+         int32_t size;                    ///< File size, -1 for directories
+      } entry_t;
+
+      M2MIndex();
+
+      void begin(const char *path);
+      bool add(const char *name, int size);
+      void end();
+
+      lookup_t find(const char *file_name, int &size);
+      const entry_t *entries(const char *path, int &count);
+      void invalidate(const char *file_name);
+      void drop(const char *path);
+      void clear();
+
+      static const char *split(const char *file_name, char *path, size_t size);
+
+      private:
+
+      /*! \struct dir_t
+         \brief Indexed directory
+      */
+      typedef struct
+      {
+         char path[ME310_M2M_NAME_SIZE];  ///< Directory path, without trailing '/'
+         uint16_t first;                  ///< Index of the first entry in the pool
+         uint16_t count;                  ///< Number of entries
+         uint32_t used;                   ///< Last use, for the eviction
+         bool complete;                   ///< False if the listing did not fit the pool
+      } dir_t;
+
+      int lookup(const char *path);
+      void remove(int index);
+      static void normalize(const char *path, char *dst, size_t size);
+
+      dir_t _dirs[M2M_INDEX_MAX_DIRS];          //!< Indexed directories
+      int _dirCount;                            //!< Number of indexed directories
+      entry_t _entries[M2M_INDEX_MAX_ENTRIES];  //!< Entries of the directories, each one in a contiguous block
+      int _entryCount;                          //!< Number of used entries
+      int _building;                            //!< Index of the directory between begin() and end(), -1 if none
+      uint32_t _clock;                          //!< Use counter
+   };
+} // end namespace
+
+#endif //__M2MINDEX__H
@@ -0,0 +1,293 @@
+/*Copyright (C) 2026 Telit Communications S.p.A. Italy - All Rights Reserved.*/
+/*    See LICENSE file in the project root for full license information.     */
+
+/**
+  @file
+    M2MJournal.cpp
+
+  @brief
+    Append only journal of telemetry records on the module file system
+
+  @details
+    The class buffers records in RAM and writes them to the module file system in batches, one file
+    for each flush, so that samples taken without coverage are kept with few flash writes.\n
+
+  @version
+    2.13.1
+
+  @note
+    Dependencies:
+    M2MJournal.h
+
+  @author
+
+  @date
+    18/10/2026
+*/
+
+#include "M2MJournal.h"
+
+using namespace me310;
+
+//! \brief Class Constructor
+/*!
+ * \param module    driver used for the file system commands
+ * \param name      name of the journal files, with path, e.g. "/data/tlm"
+ * \param memory    memory used for the records, half for the appended ones and half for the replay
+ * \param size      size of the memory in bytes, each flush writes at most size/2 bytes
+ */
+M2MJournal::M2MJournal(ME310 &module, const char *name, uint8_t *memory, size_t size) :
+   _module(module), _write(memory), _read(memory + size / 2), _size(size / 2), _len(0), _readLen(0),
+   _first(0), _next(0), _offset(0), _dropped(0)
+{
+   snprintf(_name, sizeof(_name), "%s", name);
+}
+
+//! \brief Loads the cursor file
+/*! \details
+To be called once at startup, before the other methods, to continue the journal left by a previous run.
+If the cursor file does not exist the journal starts empty.
+ * \param aTimeout timeout in ms of each command
+ * \return return code
+ */
+ME310::return_t M2MJournal::begin(ME310::tout_t aTimeout)
+{
+   char cursor[ME310_M2M_NAME_SIZE];
+   snprintf(cursor, sizeof(cursor), "%s.cur", _name);
+   _first = _next = _offset = 0;
+   ME310::return_t ret = _module.m2m_file_exists(cursor, aTimeout);
+   if(ret == ME310::RETURN_ERROR)
+   {
+      return ME310::RETURN_VALID;
+   }
+   if(ret != ME310::RETURN_VALID)
+   {
+      return ret;
+   }
+   _readLen = 0;
+   ret = _module.m2m_read_file(cursor, copy_sink, this, -1, aTimeout);
+   if(ret != ME310::RETURN_VALID)
+   {
+      return ret;
+   }
+   /* <first>,<next>,<offset> */
+   char text[M2M_JOURNAL_CURSOR_SIZE];
+   size_t len = (_readLen < sizeof(text) - 1) ? _readLen : sizeof(text) - 1;
+   memcpy(text, _read, len);
+   text[len] = 0;
+   char *p = text;
+   uint32_t first = strtoul(p, &p, 10);
+   uint32_t next = (*p == ',') ? strtoul(p + 1, &p, 10) : 0;
+   uint32_t offset = (*p == ',') ? strtoul(p + 1, &p, 10) : 0;
+   if(next < first || next - first > M2M_JOURNAL_MAX_FILES)
+   {
+      return ME310::RETURN_ERROR;
+   }
+   _first = first;
+   _next = next;
+   _offset = offset;
+   return ME310::RETURN_VALID;
+}
+
+//! \brief Appends a record
+/*! \details
+The record is copied in RAM. If it does not fit the records collected so far are flushed first.
+ * \param record    record data
+ * \param len       record length, up to max_record()
+ * \param aTimeout timeout in ms of each command of the flush
+ * \return RETURN_ERROR if the record is too long, otherwise the return code of the flush, if any
+ */
+ME310::return_t M2MJournal::append(const uint8_t *record, size_t len, ME310::tout_t aTimeout)
+{
+   if(record == NULL || len > max_record())
+   {
+      return ME310::RETURN_ERROR;
+   }
+   if(_len + 2 + len > _size)
+   {
+      ME310::return_t ret = flush(aTimeout);
+      if(ret != ME310::RETURN_VALID)
+      {
+         return ret;
+      }
+   }
+   _write[_len++] = (uint8_t)(len & 0xFF);
+   _write[_len++] = (uint8_t)(len >> 8);
+   memcpy(_write + _len, record, len);
+   _len += len;
+   return ME310::RETURN_VALID;
+}
+
+//! \brief Writes the collected records in a new journal file
+/*! \details
+If M2M_JOURNAL_MAX_FILES files are waiting for the replay, the oldest one is deleted. The records stay in RAM
+if the write fails.
+ * \param aTimeout timeout in ms of each command
+ * \return return code
+ */
+ME310::return_t M2MJournal::flush(ME310::tout_t aTimeout)
+{
+   if(_len == 0)
+   {
+      return ME310::RETURN_VALID;
+   }
+   if(files() >= M2M_JOURNAL_MAX_FILES)
+   {
+      drop_first(aTimeout);
+   }
+   char file[ME310_M2M_NAME_SIZE];
+   file_name(_next, file);
+   ME310::return_t ret = _module.m2m_write_file(file, _len, 0, (char*)_write, aTimeout);
+   if(ret != ME310::RETURN_VALID)
+   {
+      return ret;
+   }
+   _next++;
+   _len = 0;
+   return save_cursor(aTimeout);
+}
+
+//! \brief Replays the journal records in order
+/*! \details
+The records in RAM are flushed first, then each file is read and its records are passed to the sink from the
+oldest one. Files completely replayed are deleted. The sink can send commands and append records.\n
+When the sink returns false the replay stops and the refused record is the first one of the next replay.
+A file is dropped only when the module reports it as missing or it is larger than a journal file; a timeout
+stops the replay and keeps the file.
+ * \param sink       function receiving the records
+ * \param context    pointer passed back to the sink
+ * \param aTimeout timeout in ms of each command
+ * \return return code
+ */
+ME310::return_t M2MJournal::replay(sink_t sink, void *context, ME310::tout_t aTimeout)
+{
+   if(sink == NULL)
+   {
+      return ME310::RETURN_ERROR;
+   }
+   ME310::return_t ret = flush(aTimeout);
+   if(ret != ME310::RETURN_VALID)
+   {
+      return ret;
+   }
+   while(_first != _next)
+   {
+      uint32_t seq = _first;
+      char file[ME310_M2M_NAME_SIZE];
+      file_name(seq, file);
+      int size;
+      ret = _module.m2m_file_size(file, size, aTimeout);
+      if(ret != ME310::RETURN_VALID && ret != ME310::RETURN_ERROR)
+      {
+         /* the module did not answer, the file is read again by the next replay */
+         return ret;
+      }
+      if(ret == ME310::RETURN_ERROR || size > (int)_size)
+      {
+         /* missing or not written by the journal */
+         drop_first(aTimeout);
+         _dropped--;
+         continue;
+      }
+      _readLen = 0;
+      ret = _module.m2m_read_file(file, copy_sink, this, size, aTimeout);
+      if(ret != ME310::RETURN_VALID)
+      {
+         return ret;
+      }
+      size_t pos = _offset;
+      while(pos + 2 <= _readLen)
+      {
+         size_t len = _read[pos] | (_read[pos+1] << 8);
+         if(pos + 2 + len > _readLen)
+         {
+            break;
+         }
+         if(!sink(_read + pos + 2, len, context))
+         {
+            if(_first != seq)
+            {
+               /* dropped by a flush of the sink */
+               break;
+            }
+            _offset = pos;
+            return save_cursor(aTimeout);
+         }
+         if(_first != seq)
+         {
+            break;
+         }
+         pos += 2 + len;
+      }
+      if(_first == seq)
+      {
+         _module.m2m_delete(file, aTimeout);
+         _first++;
+         _offset = 0;
+         ret = save_cursor(aTimeout);
+         if(ret != ME310::RETURN_VALID)
+         {
+            return ret;
+         }
+      }
+   }
+   return ME310::RETURN_VALID;
+}
+
+//! \brief Builds the name of a journal file
+/*!
+ * \param seq    file sequence number
+ * \param dst    receives the name, ME310_M2M_NAME_SIZE bytes
+ */
+void M2MJournal::file_name(uint32_t seq, char *dst) const
+{
+   snprintf(dst, ME310_M2M_NAME_SIZE, "%s.%u", _name, (unsigned int)(seq % M2M_JOURNAL_MAX_FILES));
+}
+
+//! \brief Writes the cursor file
+/*!
+ * \param aTimeout timeout in ms
+ * \return return code
+ */
+ME310::return_t M2MJournal::save_cursor(ME310::tout_t aTimeout)
+{
+   char cursor[ME310_M2M_NAME_SIZE];
+   char text[M2M_JOURNAL_CURSOR_SIZE];
+   snprintf(cursor, sizeof(cursor), "%s.cur", _name);
+   int len = snprintf(text, sizeof(text), "%lu,%lu,%lu", (unsigned long)_first, (unsigned long)_next, (unsigned long)_offset);
+   return _module.m2m_write_file(cursor, len, 0, text, aTimeout);
+}
+
+//! \brief Deletes the oldest journal file
+/*!
+ * \param aTimeout timeout in ms
+ * \return return code of the delete command
+ */
+ME310::return_t M2MJournal::drop_first(ME310::tout_t aTimeout)
+{
+   char file[ME310_M2M_NAME_SIZE];
+   file_name(_first, file);
+   _first++;
+   _offset = 0;
+   _dropped++;
+   return _module.m2m_delete(file, aTimeout);
+}
+
+//! \brief Sink of ME310::m2m_read_file() copying the file in the replay memory
+/*!
+ * \param data       chunk of the file
+ * \param len        length of the chunk
+ * \param context    the journal
+ * \return false if the file does not fit the replay memory
+ */
+bool M2MJournal::copy_sink(const uint8_t *data, size_t len, void *context)
+{
+   M2MJournal *journal = (M2MJournal*)context;
+   if(journal->_readLen + len > journal->_size)
+   {
+      return false;
+   }
+   memcpy(journal->_read + journal->_readLen, data, len);
+   journal->_readLen += len;
+   return true;
+}
@@ -0,0 +1,91 @@
+/*Copyright (C) 2026 Telit Communications S.p.A. Italy - All Rights Reserved.*/
+/*    See LICENSE file in the project root for full license information.     */
+
+/**
+  @file
+    M2MJournal.h
+
+  @brief
+    Append only journal of telemetry records on the module file system
+
+  @details
+    The class buffers records in RAM and writes them to the module file system in batches, one file
+    for each flush, so that samples taken without coverage are kept with few flash writes.\n
+    The records are replayed in order through a sink; the replay position is kept in a cursor file
+    so that it resumes after a reboot.
+
+  @version
+    2.13.1
+
+  @note
+    Dependencies:
+    ME310.h
+
+  @author
+
+  @date
+    18/10/2026
+*/
+#ifndef __M2MJOURNAL__H
+#define __M2MJOURNAL__H
+
+/* Include files ================================================================================*/
+#include "ME310.h"
+
+namespace me310
+{
+   #define M2M_JOURNAL_MAX_FILES 16      ///< Max number of journal files, the oldest is dropped when a new one is needed
+   #define M2M_JOURNAL_CURSOR_SIZE 40    ///< Max length of the cursor file content
+
+   /*! \class M2MJournal
+      \brief Journal of records stored in rotating module files
+      \details
+      The memory given to the constructor is split in two halves: the first one collects the appended records,
+      the second one holds the file being replayed, so records can be appended from the replay sink.
+      Each flush writes the collected records in a new file named <name>.<n>; when M2M_JOURNAL_MAX_FILES files
+      are waiting, the oldest one is deleted and its records are counted as dropped.\n
+      Records are stored as a 2 bytes little endian length followed by the data. The cursor file <name>.cur keeps
+      the first and next file sequence numbers and the offset of the next record to replay: it is written after
+      each flush and after each replayed file, so after a reboot the records of a partially replayed file can be
+      delivered again.
+   */
+   class M2MJournal
+   {
+      public:
+
+      typedef bool (*sink_t)(const uint8_t *record, size_t len, void *context);   //!< Receives a replayed record, returns false to stop the replay
+
+      M2MJournal(ME310 &module, const char *name, uint8_t *memory, size_t size);
+
+      ME310::return_t begin(ME310::tout_t aTimeout = ME310::TOUT_1SEC);
+      ME310::return_t append(const uint8_t *record, size_t len, ME310::tout_t aTimeout = ME310::TOUT_1SEC);
+      ME310::return_t flush(ME310::tout_t aTimeout = ME310::TOUT_1SEC);
+      ME310::return_t replay(sink_t sink, void *context = NULL, ME310::tout_t aTimeout = ME310::TOUT_1SEC);
+
+      size_t pending() const { return _len; }                        //!< Returns the number of bytes not flushed yet
+      uint32_t files() const { return _next - _first; }              //!< Returns the number of files waiting for the replay
+      uint32_t dropped() const { return _dropped; }                  //!< Returns the number of files dropped by the rotation
+      size_t max_record() const { return _size > 2 ? _size - 2 : 0; }   //!< Returns the max length of a record
+
+      private:
+
+      void file_name(uint32_t seq, char *dst) const;
+      ME310::return_t save_cursor(ME310::tout_t aTimeout);
+      ME310::return_t drop_first(ME310::tout_t aTimeout);
+      static bool copy_sink(const uint8_t *data, size_t len, void *context);
+
+      ME310 &_module;                          //!< Driver used for the file system commands
+      char _name[ME310_M2M_NAME_SIZE - 4];     //!< Name of the journal files, with path
+      uint8_t *_write;                         //!< Records not flushed yet
+      uint8_t *_read;                          //!< File being replayed
+      size_t _size;                            //!< Size of each half of the memory
+      size_t _len;                             //!< Bytes in _write
+      size_t _readLen;                         //!< Bytes in _read
+      uint32_t _first;                         //!< Sequence number of the oldest file
+      uint32_t _next;                          //!< Sequence number of the next file to write
+      uint32_t _offset;                        //!< Offset of the next record to replay in the oldest file
+      uint32_t _dropped;                       //!< Number of files dropped by the rotation
+   };
+} // end namespace
+
+#endif //__M2MJOURNAL__H
@@ -32,6 +32,11 @@
 #include <stdio.h>
 #include <ATCommandDataParsing.h>
 #include <PathParsing.h>
+#include <MQTTRouter.h>
+#include <LWM2MDispatcher.h>
+#include <LWM2MObjectTree.h>
+#include <M2MIndex.h>
+#include <NMEAParser.h>
 #include <vector>
 
 using namespace telitAT;
@@ -107,6 +112,7 @@ void ME310::powerOn(unsigned int onoff_gpio)
       break;
     }
     mSerial.end();
+    invalidate_http_profile();
     digitalWrite(onoff_gpio, HIGH);
     digitalWrite(LED_BUILTIN, HIGH);
     delay(6000);
@@ -181,13 +187,14 @@ ME310::return_t ME310::select_interface_style(int value, tout_t aTimeout)
 
 //! \brief Implements the AT&F command and waits for OK answer
 /*! \details
-Set configuration parameters to default values.
+Set configuration parameters to default values. The cached HTTP profile configuration is invalidated.
  * \param value    configuration value
  * \param aTimeout timeout in ms
  * \return return code
  */
 ME310::return_t ME310::set_factory_config (int value, tout_t aTimeout)
 {
+   invalidate_http_profile();
    memset(mBuffer, 0, ME310_BUFFSIZE);
    snprintf((char *)mBuffer, ME310_BUFFSIZE-1, F("AT&F%d"), value);
    return send_wait((char*)mBuffer, OK_STRING, aTimeout);
@@ -195,13 +202,14 @@ ME310::return_t ME310::set_factory_config (int value, tout_t aTimeout)
 
 //! \brief Implements the ATZ command and waits for OK answer
 /*! \details
-Soft Reset
+Soft Reset. The cached HTTP profile configuration is invalidated.
  * \param value    reset type
  * \param aTimeout timeout in ms
  * \return return code
  */
 ME310::return_t ME310::soft_reset (int value, tout_t aTimeout)
 {
+   invalidate_http_profile();
    memset(mBuffer, 0, ME310_BUFFSIZE);
    snprintf((char *)mBuffer, ME310_BUFFSIZE-1, F("ATZ%d"), value);
    return send_wait((char*)mBuffer,OK_STRING,aTimeout);
@@ -1768,6 +1776,144 @@ ME310::return_t ME310::eps_network_registration_status(int mode, tout_t aTimeout
    return send_wait((char*)mBuffer, OK_STRING, aTimeout);
 }
 
+//! \brief Enables the network registration unsolicited codes
+/*! \details
+Sends AT+CREG=2, AT+CGREG=2 and AT+CEREG=2, then reads the current state of each domain. From then on the
++CREG, +CGREG and +CEREG codes, with location and access technology, update the state returned by
+registration() whenever they are received, both while waiting for answers and in poll_unsolicited().
+ * \param aTimeout timeout in ms of each command
+ * \return return code of the first failed command
+ */
+ME310::return_t ME310::registration_enable_indications(tout_t aTimeout)
+{
+   return_t rc = network_registration_status(2, aTimeout);
+   if(rc == RETURN_VALID)
+   {
+      rc = gprs_network_registration_status(2, aTimeout);
+   }
+   if(rc == RETURN_VALID)
+   {
+      rc = eps_network_registration_status(2, aTimeout);
+   }
+   /* the answers update the state like the unsolicited codes */
+   if(rc == RETURN_VALID)
+   {
+      rc = read_network_registration_status(aTimeout);
+   }
+   if(rc == RETURN_VALID)
+   {
+      rc = read_gprs_network_registration_status(aTimeout);
+   }
+   if(rc == RETURN_VALID)
+   {
+      rc = read_eps_network_registration_status(aTimeout);
+   }
+   return rc;
+}
+
+//! \brief Waits until the packet domain is registered
+/*! \details
+Reads the unsolicited codes and returns as soon as +CGREG or +CEREG reports the registration, home or
+roaming. The indications must be enabled with registration_enable_indications().
+ * \param aTimeout    max time to wait in ms
+ * \param aLineTimeout timeout in ms waiting for each line
+ * \return RETURN_VALID if registered, RETURN_TOUT otherwise
+ */
+ME310::return_t ME310::wait_until_registered(uint32_t aTimeout, tout_t aLineTimeout)
+{
+   uint32_t start = millis();
+   while(!registered())
+   {
+      if(millis() - start >= aTimeout)
+      {
+         on_timeout();
+         return RETURN_TOUT;
+      }
+      on_receive();
+      mBuffLen = 0;
+      mpBuffer = mBuffer;
+      memset(mBuffer, 0, ME310_BUFFSIZE);
+      int len = read_raw_line((char*)mBuffer, ME310_BUFFSIZE, aLineTimeout);
+      if(len > 0)
+      {
+         mBuffLen = len + 1;
+         process_unsolicited((const char*)mBuffer);
+         on_message((const char*)mBuffer);
+      }
+   }
+   return RETURN_VALID;
+}
+
+//! \brief Parses a network registration unsolicited code or read answer
+/*! \details
+Recognized formats are the unsolicited codes +CREG: <stat>[,<lac>,<ci>[,<AcT>]],
++CGREG: <stat>[,<lac>,<ci>[,<AcT>,<rac>]] and +CEREG: <stat>[,<tac>,<ci>[,<AcT>]], and the answers to the
+read commands, which start with the <n> field.
+ * \param aLine      line received from the module
+ * \param domain     receives the domain of the code
+ * \param state      filled with the state; the timestamp is not changed
+ * \return true if the line is a registration code
+ */
+bool ME310::parse_registration(const char *aLine, registration_domain_t &domain, registration_t &state)
+{
+   const char *p;
+   if(strncmp(aLine, "+CREG: ", 7) == 0)
+   {
+      domain = REGISTRATION_CS;
+      p = aLine + 7;
+   }
+   else if(strncmp(aLine, "+CGREG: ", 8) == 0)
+   {
+      domain = REGISTRATION_GPRS;
+      p = aLine + 8;
+   }
+   else if(strncmp(aLine, "+CEREG: ", 8) == 0)
+   {
+      domain = REGISTRATION_EPS;
+      p = aLine + 8;
+   }
+   else
+   {
+      return false;
+   }
+   if(*p < '0' || *p > '9')
+   {
+      return false;   /* test command answer */
+   }
+
+   /* fields without quotes, up to <AcT> of a read answer */
+   char fields[5][12];
+   int count = 0;
+   bool secondQuoted = false;
+   while(count < 5)
+   {
+      size_t len = 0;
+      for(; *p != 0 && *p != ','; p++)
+      {
+         if(*p == '"')
+         {
+            secondQuoted = secondQuoted || (count == 1);
+         }
+         else if(*p != ' ' && len < sizeof(fields[0]) - 1)
+         {
+            fields[count][len++] = *p;
+         }
+      }
+      fields[count++][len] = 0;
+      if(*p != ',')
+      {
+         break;
+      }
+      p++;
+   }
+   int first = (count > 1 && !secondQuoted && fields[1][0] != 0) ? 1 : 0;
+   state.stat = atoi(fields[first]);
+   state.area = (first + 1 < count) ? strtoul(fields[first + 1], NULL, 16) : 0;
+   state.cell = (first + 2 < count) ? strtoul(fields[first + 2], NULL, 16) : 0;
+   state.act = (first + 3 < count && fields[first + 3][0] != 0) ? atoi(fields[first + 3]) : -1;
+   return true;
+}
+
 //! \brief Implements the AT\#RFSTS command and waits for OK answer
 /*! \details
 Command reads current network status.
@@ -2249,7 +2395,12 @@ ME310::return_t ME310::preferred_message_storage(const char *memr, const char *m
 {
    memset(mBuffer, 0, ME310_BUFFSIZE);
    snprintf((char *)mBuffer, ME310_BUFFSIZE-1, F("AT+CPMS=\"%s\",\"%s\",\"%s\""), memr, memw, mems);
-   return send_wait((char*)mBuffer, OK_STRING, aTimeout);
+   return_t ret = send_wait((char*)mBuffer, OK_STRING, aTimeout);
+   if(ret == RETURN_VALID)
+   {
+      snprintf(mSmsMemory, sizeof(mSmsMemory), "%s", memr);
+   }
+   return ret;
 }
 
 //! \brief Implements the AT+CMGF command and waits for OK answer
@@ -2474,6 +2625,71 @@ ME310::return_t ME310::read_message(int index, tout_t aTimeout)
    return send_wait((char*)mBuffer, OK_STRING, aTimeout);
 }
 
+//! \brief Reads a message from the storage with AT+CMGR
+/*! \details
+The text is kept in the class memory buffer, joined with '\n' if it spans more lines; in PDU mode it is the PDU
+in hex, to be decoded with SMSPDU::decode(). The text is read by the <length> of the header, reported in PDU mode
+and in text mode with AT+CSDH=1; without it a text equal to a final result code, e.g. "OK", cannot be told from
+the end of the answer.
+ * \param index    message index
+ * \param message    filled with the message
+ * \param aTimeout timeout in ms waiting for each line
+ * \return RETURN_DATA if the message has been read, RETURN_VALID if the module answers OK with no message,
+ * otherwise the error
+ */
+ME310::return_t ME310::read_message(int index, sms_message_t &message, tout_t aTimeout)
+{
+   char command[ME310_BUFFCOMMANDSIZE];
+   char *line = (char*)mBuffer;
+   snprintf(command, sizeof(command)-1, F("AT+CMGR=%d"), index);
+   send(command, F("\r"));
+   on_receive();
+   mBuffLen = 0;
+   mpBuffer = mBuffer;
+   memset(mBuffer, 0, ME310_BUFFSIZE);
+   for(;;)
+   {
+      int len = read_raw_line(line, ME310_BUFFSIZE, aTimeout);
+      if(len < 0)
+      {
+         on_timeout();
+         return RETURN_TOUT;
+      }
+      if(len == 0)
+      {
+         continue;
+      }
+      if(parse_sms_header(line, message))
+      {
+         break;
+      }
+      if(str_equal(line, OK_STRING))
+      {
+         on_valid(line);
+         return RETURN_VALID;
+      }
+      if(sms_list_boundary(line))
+      {
+         on_error(line);
+         return RETURN_ERROR;
+      }
+      process_unsolicited(line);
+   }
+   message.index = index;
+   if(!read_sms_text(message, aTimeout))
+   {
+      on_timeout();
+      return RETURN_TOUT;
+   }
+   if(!str_equal(mSmsHeader, OK_STRING))
+   {
+      on_error(mSmsHeader);
+      return RETURN_ERROR;
+   }
+   on_valid(mSmsHeader);
+   return RETURN_DATA;
+}
+
 //! \brief Implements the AT+CMGS command and waits for OK answer
 /*! \details
 The command is related to sending short messages.
@@ -2597,113 +2813,669 @@ ME310::return_t ME310::delete_message(int index, int delflag, tout_t aTimeout)
    return send_wait((char*)mBuffer,OK_STRING,aTimeout);
 }
 
-//! \brief Implements the AT+CGSMS command and waits for OK answer
+//! \brief Starts a streamed AT+CMGL listing
 /*! \details
-Set command is used to specify the service or service preference that the MT will use to send MO SMS
-messages.
- * \param service    indicates the service or service preference to be used
+The records are read one at a time with sms_list_next(), as the module sends them, so the listing is not
+limited by the size of the buffer. No other command can be sent until the listing is ended by
+sms_list_end(). In text mode AT+CSDH=1 (show_text_mode_parameters(1)) makes the module report the length of
+each text, which is needed to read texts equal to a final result code, e.g. "OK".
+ * \param stat    messages to list, e.g. "REC UNREAD" or "ALL" in text mode, 0 or 4 in PDU mode, NULL for the default (unread)
  * \param aTimeout timeout in ms
  * \return return code
  */
-ME310::return_t ME310::select_service_mo_sms(int service, tout_t aTimeout)
+ME310::return_t ME310::sms_list_begin(const char *stat, tout_t aTimeout)
 {
+   char command[ME310_BUFFCOMMANDSIZE];
+   if(stat == NULL)
+   {
+      snprintf(command, sizeof(command)-1, F("AT+CMGL"));
+   }
+   else if(*stat >= '0' && *stat <= '9')
+   {
+      snprintf(command, sizeof(command)-1, F("AT+CMGL=%s"), stat);
+   }
+   else
+   {
+      snprintf(command, sizeof(command)-1, F("AT+CMGL=\"%s\""), stat);
+   }
+   send(command, F("\r"));
+   on_receive();
+   mBuffLen = 0;
+   mpBuffer = mBuffer;
    memset(mBuffer, 0, ME310_BUFFSIZE);
-   snprintf((char *)mBuffer, ME310_BUFFSIZE-1, F("AT+CGSMS=%d"), service);
-   return send_wait((char*)mBuffer, OK_STRING, aTimeout);
+   mSmsListing = true;
+   mSmsListAll = (stat != NULL && (strcmp(stat, "ALL") == 0 || strcmp(stat, "4") == 0));
+   mSmsOnlyReceived = true;
+   mSmsListComplete = false;
+   mSmsListSized = true;
+   mSmsHeader[0] = 0;
+   mSmsListed = 0;
+   mSmsMarked = 0;
+   memset(mSmsDelete, 0, sizeof(mSmsDelete));
+   return RETURN_VALID;
 }
 
-//! \brief Implements the AT\#SMSMODE command and waits for OK answer
+//! \brief Reads the next record of the listing started by sms_list_begin()
 /*! \details
-SMS Commands Operation Mode.
- * \param mode    Enables/disables the check for presence of SCA in FDN phonebook
- * \param aTimeout timeout in ms
- * \return return code
+The text of the record is kept in the class memory buffer; lines of a multi-line text are joined with '\n'.
+ * \param message    filled with the record
+ * \param aTimeout timeout in ms waiting for each line
+ * \return RETURN_DATA if a record has been read, RETURN_VALID at the end of the listing, otherwise the error
  */
-ME310::return_t ME310::sms_commands_operation_mode(int mode, tout_t aTimeout)
+ME310::return_t ME310::sms_list_next(sms_message_t &message, tout_t aTimeout)
 {
-   memset(mBuffer, 0, ME310_BUFFSIZE);
-   snprintf((char *)mBuffer, ME310_BUFFSIZE-1, F("AT#SMSMODE=%d"), mode);
-   return send_wait((char*)mBuffer, OK_STRING, aTimeout);
+   if(!mSmsListing)
+   {
+      return RETURN_VALID;
+   }
+   char *line = (char*)mBuffer;
+   while(mSmsHeader[0] == 0)
+   {
+      int len = read_raw_line(line, ME310_BUFFSIZE, aTimeout);
+      if(len < 0)
+      {
+         mSmsListing = false;
+         on_timeout();
+         return RETURN_TOUT;
+      }
+      if(len == 0)
+      {
+         continue;
+      }
+      if(sms_list_boundary(line))
+      {
+         snprintf(mSmsHeader, sizeof(mSmsHeader), "%s", line);
+      }
+      else
+      {
+         process_unsolicited(line);
+      }
+   }
+   if(str_equal(mSmsHeader, OK_STRING))
+   {
+      mSmsListing = false;
+      mSmsListComplete = true;
+      on_valid(mSmsHeader);
+      return RETURN_VALID;
+   }
+   if(!parse_sms_header(mSmsHeader, message))
+   {
+      mSmsListing = false;
+      on_error(mSmsHeader);
+      return RETURN_ERROR;
+   }
+   mSmsHeader[0] = 0;
+   mSmsListed++;
+   if(message.stat > 1)
+   {
+      mSmsOnlyReceived = false;
+   }
+   if(message.size < 0)
+   {
+      mSmsListSized = false;
+   }
+
+   if(!read_sms_text(message, aTimeout))
+   {
+      mSmsListing = false;
+      on_timeout();
+      return RETURN_TOUT;
+   }
+   return RETURN_DATA;
 }
 
-//! \brief Implements the AT\#CMGLCONCINDEX command and waits for OK answer
+//! \brief Marks a listed message for deletion
 /*! \details
-The command reports list of all concatenated SMS
- * \param aTimeout timeout in ms
- * \return return code
+The messages are deleted by sms_list_end(), after the listing.
+ * \param index    message index
+ * \return false if the index is greater than ME310_SMS_MAX_INDEX
  */
-ME310::return_t ME310::report_concatenated_sms_indexes(tout_t aTimeout)
+bool ME310::sms_list_delete(int index)
 {
-   return send_wait(F("AT#CMGLCONCINDEX"), OK_STRING, aTimeout);
+   if(index < 0 || index > ME310_SMS_MAX_INDEX)
+   {
+      return false;
+   }
+   if(!(mSmsDelete[index / 8] & (1 << (index % 8))))
+   {
+      mSmsDelete[index / 8] |= (uint8_t)(1 << (index % 8));
+      mSmsMarked++;
+   }
+   return true;
 }
 
-//! \brief Implements the AT\#E2SMSRI command and waits for OK answer
+//! \brief Ends the listing and deletes the marked messages
 /*! \details
-This set command enables/disables the Ring Indicator pin response to an incoming SMS message. If enabled,
-a negative going pulse is generated when receiving an incoming SMS message.
- * \param n    RI enabling
+The records not read yet are skipped. When all the messages have been listed and marked, and all of them are
+received messages, they are deleted with a single AT+CMGD=1,1 (delete all read messages); otherwise each
+marked message is deleted with AT+CMGD=<index>. A listing aborted by a timeout or an error only deletes the
+marked messages, since the module may have sent, and marked as read, records that were not delivered.
+The single deletion also requires every record to report the <length> of its text (AT+CSDH=1 in text mode),
+otherwise a text equal to a final result code could have ended the listing early.
  * \param aTimeout timeout in ms
- * \return return code
+ * \return return code of the listing or of the first failed deletion
  */
-ME310::return_t ME310::sms_ring_indicator(int n, tout_t aTimeout)
+ME310::return_t ME310::sms_list_end(tout_t aTimeout)
 {
-   memset(mBuffer, 0, ME310_BUFFSIZE);
-   snprintf((char *)mBuffer, ME310_BUFFSIZE-1, F("AT#E2SMSRI=%d"), n);
-   return send_wait((char*)mBuffer, OK_STRING, aTimeout);
+   sms_message_t message;
+   return_t ret = RETURN_VALID;
+   while(mSmsListing)
+   {
+      ret = sms_list_next(message, aTimeout);
+      if(ret != RETURN_DATA && ret != RETURN_VALID)
+      {
+         return ret;
+      }
+   }
+   if(mSmsMarked == 0)
+   {
+      return RETURN_VALID;
+   }
+   if(mSmsListComplete && mSmsListSized && mSmsListAll && mSmsOnlyReceived && mSmsMarked == mSmsListed)
+   {
+      /* listed messages have become read, no other read message is left */
+      ret = delete_message(1, 1, aTimeout);
+   }
+   else
+   {
+      for(int index = 0; index <= ME310_SMS_MAX_INDEX; index++)
+      {
+         if(mSmsDelete[index / 8] & (1 << (index % 8)))
+         {
+            return_t rc = delete_message(index, 0, aTimeout);
+            if(rc != RETURN_VALID && ret == RETURN_VALID)
+            {
+               ret = rc;
+            }
+         }
+      }
+   }
+   mSmsMarked = 0;
+   memset(mSmsDelete, 0, sizeof(mSmsDelete));
+   return ret;
 }
 
-//! \brief Implements the AT\#SMOV command and waits for OK answer
+//! \brief Lists the messages and deletes the ones accepted by a handler
 /*! \details
-The command is used to enable the SMS overflow signaling functionality.
- * \param mode    signaling functionality mode
+The handler is called for each message while the listing is in progress, so it must not send commands.
+ * \param stat    messages to list, as in sms_list_begin()
+ * \param handler    function receiving the messages, returns true to delete the message
+ * \param context    pointer passed back to the handler
  * \param aTimeout timeout in ms
  * \return return code
  */
-ME310::return_t ME310::sms_overflow(int mode, tout_t aTimeout)
+ME310::return_t ME310::sms_drain(const char *stat, sms_handler_t handler, void *context, tout_t aTimeout)
 {
-   memset(mBuffer, 0, ME310_BUFFSIZE);
-   snprintf((char *)mBuffer, ME310_BUFFSIZE-1, F("AT#SMOV=%d"), mode);
-   return send_wait((char*)mBuffer, OK_STRING, aTimeout);
+   sms_message_t message;
+   return_t ret = sms_list_begin(stat, aTimeout);
+   while(ret == RETURN_VALID)
+   {
+      ret = sms_list_next(message, aTimeout);
+      if(ret == RETURN_VALID)
+      {
+         break;
+      }
+      if(ret == RETURN_DATA)
+      {
+         if(handler != NULL && handler(message, context))
+         {
+            sms_list_delete(message.index);
+         }
+         ret = RETURN_VALID;
+      }
+   }
+   if(ret != RETURN_VALID)
+   {
+      return ret;
+   }
+   return sms_list_end(aTimeout);
 }
 
-//! \brief Implements the AT\#SMSMOVE command and waits for OK answer
+//! \brief Enables the +CMTI indications of the new messages
 /*! \details
-This command moves selected Short Message from current memory to destination memory.
- * \param index    message index in the memory selected by +CPMS command
+Sends AT+CNMI=2,1: new messages are stored and notified with +CMTI, which the module buffers while the
+serial line is busy with a command. The indications are queued by the driver and the messages are read with
+sms_process_messages(), instead of polling the storage.
  * \param aTimeout timeout in ms
  * \return return code
  */
-ME310::return_t ME310::sms_move(int index, tout_t aTimeout)
+ME310::return_t ME310::sms_enable_indications(tout_t aTimeout)
 {
-   memset(mBuffer, 0, ME310_BUFFSIZE);
-   snprintf((char *)mBuffer, ME310_BUFFSIZE-1, F("AT#SMSMOVE=%d"), index);
-   return send_wait((char*)mBuffer, OK_STRING, aTimeout);
+   return new_message_indications_TE(2, 1, 0, 0, 0, aTimeout);
 }
 
-// Phonebook -------------------------------------------------------------------
-
-//! \brief Implements the AT+CPBS command and waits for OK answer
+//! \brief Reads the messages notified by +CMTI
 /*! \details
-This set command selects phonebook memory storage, which will be used by other phonebook commands.
- * \param storage    specify the phonebook memory storage
- * \param password    string type value representing the PIN2-code required when selecting PIN2-code locked <storage> above "FD"
- * \param aTimeout timeout in ms
- * \return return code
+Each queued message is read with AT+CMGR and given to on_sms_message(); the message is deleted if it returns
+true. If notifications have been lost because the queue was full, the unread messages are listed once and
+read the same way. The messages are read from the preferred storage set with AT+CPMS.\n
+A message whose processing times out stays queued and is read again by the next call; one answered with an
+error is dropped, so that it does not block the others. The listing marks the messages as read, so the listed
+ones not processed yet are kept for the next call too.\n
+Notifications of messages stored in a memory other than the one read by AT+CMGR, as set with
+preferred_message_storage(), are not queued and are counted by sms_other_storage_messages().
+ * \param aTimeout timeout in ms of each command
+ * \return RETURN_TOUT if a command timed out, otherwise the return code of the first failed command, RETURN_VALID if none
  */
-ME310::return_t ME310::phonebook_select_memory_storage(const char *storage, const char *password, tout_t aTimeout)
+ME310::return_t ME310::sms_process_messages(tout_t aTimeout)
 {
-   memset(mBuffer, 0, ME310_BUFFSIZE);
-   snprintf((char *)mBuffer, ME310_BUFFSIZE-1, F("AT+CPBS=\"%s\",\"%s\""), storage, password);
-   return send_wait((char*)mBuffer, OK_STRING, aTimeout);
+   return_t rc;
+   return_t ret = RETURN_VALID;
+   while(mSmsRingCount > 0)
+   {
+      int index = mSmsRing[mSmsRingHead];
+      rc = sms_process_message(index, aTimeout);
+      if(rc == RETURN_TOUT)
+      {
+         return rc;
+      }
+      /* an error is permanent, e.g. the message has been deleted by another consumer */
+      mSmsRingHead = (mSmsRingHead + 1) % ME310_SMS_RING_SIZE;
+      mSmsRingCount--;
+      if(index >= 0 && index <= ME310_SMS_MAX_INDEX)
+      {
+         mSmsUnread[index / 8] &= (uint8_t)~(1 << (index % 8));
+      }
+      if(rc != RETURN_VALID && ret == RETURN_VALID)
+      {
+         ret = rc;
+      }
+   }
+   if(mSmsRingOverflow)
+   {
+      /* AT+CMGL with no status lists the unread messages, in text and PDU mode, and marks them as read;
+         the flag is cleared first, so notifications lost while listing trigger another listing */
+      mSmsRingOverflow = false;
+      sms_message_t message;
+      rc = sms_list_begin(NULL, aTimeout);
+      while(rc == RETURN_VALID)
+      {
+         rc = sms_list_next(message, aTimeout);
+         if(rc == RETURN_DATA && message.index >= 0 && message.index <= ME310_SMS_MAX_INDEX)
+         {
+            mSmsUnread[message.index / 8] |= (uint8_t)(1 << (message.index % 8));
+         }
+         rc = (rc == RETURN_DATA) ? RETURN_VALID : rc;
+         if(!mSmsListing)
+         {
+            break;
+         }
+      }
+      if(rc == RETURN_TOUT)
+      {
+         mSmsRingOverflow = true;
+         return rc;
+      }
+      if(rc != RETURN_VALID && ret == RETURN_VALID)
+      {
+         ret = rc;
+      }
+   }
+   for(int index = 0; index <= ME310_SMS_MAX_INDEX; index++)
+   {
+      if(mSmsUnread[index / 8] & (1 << (index % 8)))
+      {
+         rc = sms_process_message(index, aTimeout);
+         if(rc == RETURN_TOUT)
+         {
+            return rc;
+         }
+         mSmsUnread[index / 8] &= (uint8_t)~(1 << (index % 8));
+         if(rc != RETURN_VALID && ret == RETURN_VALID)
+         {
+            ret = rc;
+         }
+      }
+   }
+   return ret;
 }
 
-//! \brief Implements the AT+CPBS command and waits for OK answer
-/*! \details
-This set command selects phonebook memory storage, which will be used by other phonebook commands.
- * \param storage    specify the phonebook memory storage
- * \param password    string type value representing the PIN2-code required when selecting PIN2-code locked <storage> above "FD"
- * \param aTimeout timeout in ms
- * \return return code
+//! \brief Reads a message and gives it to on_sms_message()
+/*!
+ * \param index    message index
+ * \param aTimeout timeout in ms of each command
+ * \return return code, RETURN_VALID also if the message is no longer in the storage
+ */
+ME310::return_t ME310::sms_process_message(int index, tout_t aTimeout)
+{
+   sms_message_t message;
+   return_t rc = read_message(index, message, aTimeout);
+   if(rc != RETURN_DATA)
+   {
+      return rc;
+   }
+   if(on_sms_message(message))
+   {
+      return delete_message(index, 0, aTimeout);
+   }
+   return RETURN_VALID;
+}
+
+//! \brief Queues a message to be read by sms_process_messages
+/*!
+ * \param index    message index
+ * \return false if the queue is full
+ */
+bool ME310::sms_queue(int index)
+{
+   for(int i = 0; i < mSmsRingCount; i++)
+   {
+      if(mSmsRing[(mSmsRingHead + i) % ME310_SMS_RING_SIZE] == index)
+      {
+         return true;
+      }
+   }
+   if(mSmsRingCount >= ME310_SMS_RING_SIZE)
+   {
+      return false;
+   }
+   mSmsRing[(mSmsRingHead + mSmsRingCount) % ME310_SMS_RING_SIZE] = (int16_t)index;
+   mSmsRingCount++;
+   return true;
+}
+
+//! \brief Callback function on SMS read by sms_process_messages
+/*! \details
+The default implementation calls the handler set with sms_set_handler(), if any. Commands can be sent,
+but the text is in the class memory buffer and is overwritten by them.
+ * \param message    message read from the module
+ * \return true to delete the message
+ */
+bool ME310::on_sms_message(const sms_message_t &message)
+{
+   if(mSmsHandler != NULL)
+   {
+      return mSmsHandler(message, mSmsHandlerContext);
+   }
+   return false;
+}
+
+//! \brief Reads the text of a listed or read SMS
+/*! \details
+The text lines are read up to the next +CMGL header or final result code, which is kept in mSmsHeader.
+When the header reports the <length> of the text, a line is taken as the end of the text only after that
+many characters have been read, so a text such as "OK" is not mistaken for the final result code; the
+<length> counts octets, or characters in text mode, so it is a lower bound also for texts shown in hex.
+ * \param message    receives the text, kept in the class memory buffer
+ * \param aTimeout timeout in ms waiting for each line
+ * \return false on timeout
+ */
+bool ME310::read_sms_text(sms_message_t &message, tout_t aTimeout)
+{
+   mSmsHeader[0] = 0;
+   /* text lines up to the next header or final result code, the ones that do not fit are dropped */
+   char *line = (char*)mBuffer;
+   char discard[ME310_SMS_HEADER_SIZE];
+   size_t pos = 0;
+   size_t consumed = 0;
+   while(mSmsHeader[0] == 0)
+   {
+      size_t available = ME310_BUFFSIZE - pos - 1;
+      char *text = (available > sizeof(discard)) ? line + pos : discard;
+      int len = read_raw_line(text, (text == discard) ? sizeof(discard) : available, aTimeout);
+      if(len < 0)
+      {
+         return false;
+      }
+      /* characters of the text read so far, the line breaks inside the text included */
+      size_t body = (consumed > 0) ? consumed - 1 : 0;
+      if((message.size < 0 || body >= (size_t)message.size) && sms_list_boundary(text))
+      {
+         snprintf(mSmsHeader, sizeof(mSmsHeader), "%s", text);
+         break;
+      }
+      consumed += len + 1;
+      if(text != discard)
+      {
+         pos += len;
+         line[pos++] = '\n';
+      }
+   }
+   while(pos > 0 && line[pos-1] == '\n')
+   {
+      pos--;
+   }
+   line[pos] = 0;
+   mBuffLen = pos + 1;
+   message.text = line;
+   message.len = (int)pos;
+   return true;
+}
+
+//! \brief Checks if a line ends the text of a listed SMS
+/*!
+ * \param aLine      line received from the module
+ * \return true for +CMGL headers and final result codes
+ */
+bool ME310::sms_list_boundary(const char *aLine)
+{
+   return strncmp(aLine, "+CMGL:", 6) == 0 || str_equal(aLine, OK_STRING) || str_equal(aLine, ERROR_STRING) ||
+          strncmp(aLine, CME_ERROR_STRING, strlen(CME_ERROR_STRING)) == 0 || strncmp(aLine, "+CMS ERROR:", 11) == 0;
+}
+
+//! \brief Parses the header of a listed or read SMS
+/*! \details
+Recognized formats, in text and PDU mode:\n
++CMGL: <index>,<stat>,<oa/da>,[<alpha>],[<scts>][,<tooa/toda>,<length>]\n
++CMGL: <index>,<stat>,[<alpha>],<length>\n
++CMGR: <stat>,<oa/da>,[<alpha>],[<scts>][,<tooa>,<fo>,<pid>,<dcs>,<sca>,<tosca>,<length>]\n
++CMGR: <stat>,<da>,[<alpha>][,<toda>,<fo>,<pid>,<dcs>,[<vp>],<sca>,<tosca>,<length>]\n
++CMGR: <stat>,[<alpha>],<length>\n
+In text mode <length> is reported only with AT+CSDH=1.
+ * \param aLine      line received from the module
+ * \param message    filled with index, status, address, time stamp and size; text and len are cleared
+ * \return true if the line is a +CMGL or +CMGR header
+ */
+bool ME310::parse_sms_header(const char *aLine, sms_message_t &message)
+{
+   static const char *STATUS[] = {"REC UNREAD", "REC READ", "STO UNSENT", "STO SENT"};
+   bool list;
+   if(strncmp(aLine, "+CMGL:", 6) == 0)
+   {
+      list = true;
+   }
+   else if(strncmp(aLine, "+CMGR:", 6) == 0)
+   {
+      list = false;
+   }
+   else
+   {
+      return false;
+   }
+   memset(&message, 0, sizeof(message));
+   message.index = -1;
+   message.stat = -1;
+   message.size = -1;
+   message.text = "";
+
+   /* split the fields, commas inside quotes do not separate; the fields after the fifth one share the last slot */
+   char fields[6][ME310_SMS_TIMESTAMP_SIZE];
+   bool quoted[6] = {false, false, false, false, false, false};
+   int count = 0;
+   const char *p = aLine + 6;
+   while(*p == ' ')
+   {
+      p++;
+   }
+   for(;;)
+   {
+      int slot = (count < 5) ? count : 5;
+      size_t len = 0;
+      bool inQuotes = false;
+      quoted[slot] = false;
+      for(; *p != 0 && (inQuotes || *p != ','); p++)
+      {
+         if(*p == '"')
+         {
+            inQuotes = !inQuotes;
+            quoted[slot] = true;
+         }
+         else if(len < sizeof(fields[0]) - 1)
+         {
+            fields[slot][len++] = *p;
+         }
+      }
+      fields[slot][len] = 0;
+      count++;
+      if(*p != ',')
+      {
+         break;
+      }
+      p++;
+   }
+   const char *last = fields[(count < 6) ? count - 1 : 5];
+
+   int first = 0;
+   if(list)
+   {
+      if(count < 2)
+      {
+         return false;
+      }
+      message.index = atoi(fields[0]);
+      first = 1;
+   }
+   if(quoted[first])
+   {
+      for(int i = 0; i < 4; i++)
+      {
+         if(strcmp(fields[first], STATUS[i]) == 0)
+         {
+            message.stat = i;
+         }
+      }
+      if(first + 1 < count)
+      {
+         snprintf(message.sender, sizeof(message.sender), "%s", fields[first + 1]);
+      }
+      if(first + 3 < count && first + 3 < 5)
+      {
+         snprintf(message.timestamp, sizeof(message.timestamp), "%s", fields[first + 3]);
+      }
+      /* text mode: <length> is the last field, present with AT+CSDH=1 only */
+      if(count >= (list ? 7 : 8) && *last != 0)
+      {
+         message.size = atoi(last);
+      }
+   }
+   else
+   {
+      message.stat = atoi(fields[first]);
+      if(count > first + 1 && *last != 0)
+      {
+         message.size = atoi(last);
+      }
+   }
+   return true;
+}
+
+//! \brief Implements the AT+CGSMS command and waits for OK answer
+/*! \details
+Set command is used to specify the service or service preference that the MT will use to send MO SMS
+messages.
+ * \param service    indicates the service or service preference to be used
+ * \param aTimeout timeout in ms
+ * \return return code
+ */
+ME310::return_t ME310::select_service_mo_sms(int service, tout_t aTimeout)
+{
+   memset(mBuffer, 0, ME310_BUFFSIZE);
+   snprintf((char *)mBuffer, ME310_BUFFSIZE-1, F("AT+CGSMS=%d"), service);
+   return send_wait((char*)mBuffer, OK_STRING, aTimeout);
+}
+
+//! \brief Implements the AT\#SMSMODE command and waits for OK answer
+/*! \details
+SMS Commands Operation Mode.
+ * \param mode    Enables/disables the check for presence of SCA in FDN phonebook
+ * \param aTimeout timeout in ms
+ * \return return code
+ */
+ME310::return_t ME310::sms_commands_operation_mode(int mode, tout_t aTimeout)
+{
+   memset(mBuffer, 0, ME310_BUFFSIZE);
+   snprintf((char *)mBuffer, ME310_BUFFSIZE-1, F("AT#SMSMODE=%d"), mode);
+   return send_wait((char*)mBuffer, OK_STRING, aTimeout);
+}
+
+//! \brief Implements the AT\#CMGLCONCINDEX command and waits for OK answer
+/*! \details
+The command reports list of all concatenated SMS
+ * \param aTimeout timeout in ms
+ * \return return code
+ */
+ME310::return_t ME310::report_concatenated_sms_indexes(tout_t aTimeout)
+{
+   return send_wait(F("AT#CMGLCONCINDEX"), OK_STRING, aTimeout);
+}
+
+//! \brief Implements the AT\#E2SMSRI command and waits for OK answer
+/*! \details
+This set command enables/disables the Ring Indicator pin response to an incoming SMS message. If enabled,
+a negative going pulse is generated when receiving an incoming SMS message.
+ * \param n    RI enabling
+ * \param aTimeout timeout in ms
+ * \return return code
+ */
+ME310::return_t ME310::sms_ring_indicator(int n, tout_t aTimeout)
+{
+   memset(mBuffer, 0, ME310_BUFFSIZE);
+   snprintf((char *)mBuffer, ME310_BUFFSIZE-1, F("AT#E2SMSRI=%d"), n);
+   return send_wait((char*)mBuffer, OK_STRING, aTimeout);
+}
+
+//! \brief Implements the AT\#SMOV command and waits for OK answer
+/*! \details
+The command is used to enable the SMS overflow signaling functionality.
+ * \param mode    signaling functionality mode
+ * \param aTimeout timeout in ms
+ * \return return code
+ */
+ME310::return_t ME310::sms_overflow(int mode, tout_t aTimeout)
+{
+   memset(mBuffer, 0, ME310_BUFFSIZE);
+   snprintf((char *)mBuffer, ME310_BUFFSIZE-1, F("AT#SMOV=%d"), mode);
+   return send_wait((char*)mBuffer, OK_STRING, aTimeout);
+}
+
+//! \brief Implements the AT\#SMSMOVE command and waits for OK answer
+/*! \details
+This command moves selected Short Message from current memory to destination memory.
+ * \param index    message index in the memory selected by +CPMS command
+ * \param aTimeout timeout in ms
+ * \return return code
+ */
+ME310::return_t ME310::sms_move(int index, tout_t aTimeout)
+{
+   memset(mBuffer, 0, ME310_BUFFSIZE);
+   snprintf((char *)mBuffer, ME310_BUFFSIZE-1, F("AT#SMSMOVE=%d"), index);
+   return send_wait((char*)mBuffer, OK_STRING, aTimeout);
+}
+
+// Phonebook -------------------------------------------------------------------
+
+//! \brief Implements the AT+CPBS command and waits for OK answer
+/*! \details
+This set command selects phonebook memory storage, which will be used by other phonebook commands.
+ * \param storage    specify the phonebook memory storage
+ * \param password    string type value representing the PIN2-code required when selecting PIN2-code locked <storage> above "FD"
+ * \param aTimeout timeout in ms
+ * \return return code
+ */
+ME310::return_t ME310::phonebook_select_memory_storage(const char *storage, const char *password, tout_t aTimeout)
+{
+   memset(mBuffer, 0, ME310_BUFFSIZE);
+   snprintf((char *)mBuffer, ME310_BUFFSIZE-1, F("AT+CPBS=\"%s\",\"%s\""), storage, password);
+   return send_wait((char*)mBuffer, OK_STRING, aTimeout);
+}
+
+//! \brief Implements the AT+CPBS command and waits for OK answer
+/*! \details
+This set command selects phonebook memory storage, which will be used by other phonebook commands.
+ * \param storage    specify the phonebook memory storage
+ * \param password    string type value representing the PIN2-code required when selecting PIN2-code locked <storage> above "FD"
+ * \param aTimeout timeout in ms
+ * \return return code
  */
 ME310::return_t ME310::phonebook_select_memory_storage(const char *storage, tout_t aTimeout)
 {
@@ -3306,6 +4078,7 @@ Immediate module reboot.
  */
 ME310::return_t ME310::module_reboot(tout_t aTimeout)
 {
+   invalidate_http_profile();
    return send_wait(F("AT#REBOOT"), OK_STRING, aTimeout);
 }
 
@@ -5042,7 +5815,7 @@ ME310::return_t ME310::configure_http_parameters(int prof_id, const char *server
 {
    memset(mBuffer, 0, ME310_BUFFSIZE);
    snprintf((char *)mBuffer, ME310_BUFFSIZE-1, F("AT#HTTPCFG=%d,\"%s\",%d,%d,\"%s\",\"%s\",%d,%d,%d,%d"), prof_id, server_address, server_port, auth_type, username, password, ssl_enabled, timeout, cid, pkt_size);
-   return send_wait((char*)mBuffer, OK_STRING, aTimeout);
+   return send_wait_http_cfg(prof_id, aTimeout);
 }
 
 //! \brief Implements the AT\#HTTPCFG command and waits for OK answer
@@ -5062,7 +5835,70 @@ ME310::return_t ME310::configure_http_parameters(int prof_id, const char *server
 {
    memset(mBuffer, 0, ME310_BUFFSIZE);
    snprintf((char *)mBuffer, ME310_BUFFSIZE-1, F("AT#HTTPCFG=%d,\"%s\",%d,%d,,,%d,%d,%d"), prof_id, server_address, server_port, auth_type, ssl_enabled, timeout, cid);
-   return send_wait((char*)mBuffer, OK_STRING, aTimeout);
+   return send_wait_http_cfg(prof_id, aTimeout);
+}
+
+//! \brief Configures an HTTP profile from a profile handle
+/*! \details
+This method sets the parameters of the HTTP profile with AT\#HTTPCFG. The command is issued only if
+at least one parameter differs from the last configuration accepted by the module for the same profile.
+ * \param profile    HTTP profile parameters
+ * \param aTimeout timeout in ms
+ * \return return code
+ */
+ME310::return_t ME310::configure_http_profile(const http_profile_t &profile, tout_t aTimeout)
+{
+   return configure_http_parameters(profile.prof_id, profile.server_address, profile.server_port, profile.auth_type,
+                                    profile.username ? profile.username : "", profile.password ? profile.password : "",
+                                    profile.ssl_enabled, profile.timeout, profile.cid, profile.pkt_size, aTimeout);
+}
+
+//! \brief Invalidates the cached HTTP profile configuration
+/*! \details
+This method forgets the last AT\#HTTPCFG accepted for a profile, so that the next configuration is always
+sent to the module. It is called by soft_reset() and set_factory_config(), and must be called if the module
+configuration was changed by other means.
+ * \param prof_id    profile identifier, -1 invalidates all the profiles
+ */
+void ME310::invalidate_http_profile(int prof_id)
+{
+   for(int i = 0; i < ME310_HTTP_PROFILES; i++)
+   {
+      if(prof_id < 0 || prof_id == i)
+      {
+         mHttpCfgCache[i][0] = 0;
+      }
+   }
+}
+
+//! \brief Sends the AT\#HTTPCFG command in mBuffer unless it matches the cached one
+/*! \details
+The command is skipped, returning RETURN_VALID with an empty buffer, when it is identical to the last one
+accepted by the module for the same profile. The cache is updated on OK answer and cleared on any other answer.
+ * \param prof_id    profile identifier
+ * \param aTimeout timeout in ms
+ * \return return code
+ */
+ME310::return_t ME310::send_wait_http_cfg(int prof_id, tout_t aTimeout)
+{
+   if(prof_id < 0 || prof_id >= ME310_HTTP_PROFILES || strlen((char*)mBuffer) >= ME310_HTTP_CFG_CACHE_SIZE)
+   {
+      return send_wait((char*)mBuffer, OK_STRING, aTimeout);
+   }
+   if(strcmp(mHttpCfgCache[prof_id], (char*)mBuffer) == 0)
+   {
+      mBuffLen = 0;
+      mpBuffer = mBuffer;
+      memset(mBuffer, 0, ME310_BUFFSIZE);
+      return RETURN_VALID;
+   }
+   strcpy(mHttpCfgCache[prof_id], (char*)mBuffer);
+   return_t rc = send_wait((char*)mBuffer, OK_STRING, aTimeout);
+   if(rc != RETURN_VALID)
+   {
+      mHttpCfgCache[prof_id][0] = 0;
+   }
+   return rc;
 }
 
 //! \brief Implements the AT\#HTTPQRY command and waits for OK answer
@@ -5098,6 +5934,31 @@ ME310::return_t ME310::send_http_query(int prof_id, int command, const char *res
    return send_wait((char*)mBuffer, OK_STRING, aTimeout);
 }
 
+//! \brief Implements the AT\#HTTPQRY command on a profile handle and waits for OK answer
+/*! \details
+This command performs a GET, HEAD or DELETE request to HTTP server. The profile is configured first,
+AT\#HTTPCFG being issued only if the profile parameters changed since the last request.
+ * \param profile    HTTP profile parameters
+ * \param command    identifies command requested to HTTP server
+ * \param resource    is the HTTP resource (URI), object of the request
+ * \param extra_header_line    is the optional HTTP header line
+ * \param aTimeout timeout in ms
+ * \return return code
+ */
+ME310::return_t ME310::send_http_query(const http_profile_t &profile, int command, const char *resource, const char *extra_header_line, tout_t aTimeout)
+{
+   return_t ret = configure_http_profile(profile, aTimeout);
+   if(ret != RETURN_VALID)
+   {
+      return ret;
+   }
+   if(extra_header_line == nullptr || strlen(extra_header_line) == 0)
+   {
+      return send_http_query(profile.prof_id, command, resource, aTimeout);
+   }
+   return send_http_query(profile.prof_id, command, resource, extra_header_line, aTimeout);
+}
+
 //! \brief Implements the AT\#HTTPSND command and waits for OK answer
 /*! \details
 This command performs a POST or PUT request to HTTP server and starts sending data to the server.
@@ -5156,6 +6017,35 @@ ME310::return_t ME310::send_http_send_without_params(int prof_id, int command, c
    return ret;
 }
 
+//! \brief Implements the AT\#HTTPSND command on a profile handle and waits for OK answer
+/*! \details
+This command performs a POST or PUT request to HTTP server and starts sending data to the server. The
+profile is configured first, AT\#HTTPCFG being issued only if the profile parameters changed since the
+last request.
+ * \param profile    HTTP profile parameters
+ * \param command    command requested to HTTP server
+ * \param resource    HTTP resource (uri), object of the request
+ * \param data_len    data length to send in bytes
+ * \param data    data to send
+ * \param post_param    HTTP Content-type identifier, used only for POST command
+ * \param extra_header_line    optional HTTP header line
+ * \param aTimeout timeout in ms
+ * \return return code
+ */
+ME310::return_t ME310::send_http_send(const http_profile_t &profile, int command, const char *resource, int data_len, char *data, const char *post_param, const char *extra_header_line, tout_t aTimeout)
+{
+   return_t ret = configure_http_profile(profile, aTimeout);
+   if(ret != RETURN_VALID)
+   {
+      return ret;
+   }
+   if(post_param == nullptr || strlen(post_param) == 0)
+   {
+      return send_http_send_without_params(profile.prof_id, command, resource, data_len, data, aTimeout);
+   }
+   return send_http_send(profile.prof_id, command, resource, data_len, data, post_param, extra_header_line, aTimeout);
+}
+
 //! \brief Implements the AT\#HTTPRCV command and returns
 /*! \details
 This command permits the user to read data from HTTP server in response to a previous HTTP module
@@ -6076,6 +6966,34 @@ ME310::return_t ME310::LWM2M_set_object(int agent, int objID, int instanceID, ch
    }
    return ret;
 }
+
+/*! \brief Implements the AT#LWM2MOBJSET command and wait OK answer
+/*! \details
+This function sets a object by a json string of known length. The string is written as it is after the prompt,
+so it is not limited by the class buffer and is not interpreted as a format string.
+ * \param agent identifies the agent LWM2M
+ * \param objID identifies the object LWM2M
+ * \param instanceID identifies the instance of the object
+ * \param json json string contained object parameters
+ * \param len length of the json string
+ * \param aTimeout specifies the timeout
+ * \return return code
+*/
+ME310::return_t ME310::LWM2M_set_object_json(int agent, int objID, int instanceID, const char *json, size_t len, tout_t aTimeout)
+{
+   ME310::return_t ret;
+   memset(mBuffer, 0, ME310_BUFFSIZE);
+   snprintf((char *)mBuffer, ME310_BUFFSIZE-1, F("AT#LWM2MOBJSET=%d,%d,%d"), agent, objID, instanceID);
+   ret =  send_wait((char*)mBuffer, WAIT_DATA_STRING, aTimeout);
+   if ((ret == RETURN_VALID))
+   {
+      write_payload((const uint8_t*)json, len);
+      write_payload((const uint8_t*)CTRZ, sizeof(CTRZ));
+      ret = wait_for(OK_STRING, aTimeout);
+   }
+   return ret;
+}
+
 /*! \brief Implements the AT#LWM2MR command and wait OK answer
 /*! \details
 This function selects the parameters for the read operation on the lwm2m agent, it requires the
@@ -6179,27 +7097,7 @@ correspondent lwm2m agent enabled and working.
 */
 ME310::return_t ME310::readResourceInt(int agent, int objID, int instanceID, int resourceID, int resourceInstance, int &value, tout_t aTimeout)
 {
-   ME310::return_t ret;
-   int i = 0;
-	memset(mBuffer,0,ME310_BUFFSIZE);
-	snprintf((char*)mBuffer, ME310_BUFFSIZE-1,F("AT#LWM2MR=%d,%d,%d,%d,%d"), agent,objID,instanceID,resourceID, resourceInstance);
-	ret = send_wait((char*)mBuffer,OK_STRING, aTimeout);
-   if(ret == RETURN_VALID)
-   {
-      while(buffer_cstr(i) != NULL)
-      {
-         String retValue = buffer_cstr(i);
-         if(retValue.startsWith("#LWM2MR:"))
-         {
-            int pos = retValue.indexOf(":");
-            value = atoi(retValue.substring(pos +1).c_str());
-            ret = RETURN_VALID;
-            break;
-         }
-         i++;
-      }
-   }
-   return ret;
+   return LWM2M_read_resource_int(agent, objID, instanceID, resourceID, resourceInstance, value, aTimeout);
 }
 
 /*! \brief Implements the AT#LWM2MR command and wait OK answer
@@ -6218,24 +7116,16 @@ correspondent lwm2m agent enabled and working.
 ME310::return_t ME310::LWM2M_read_resource_int(int agent, int objID, int instanceID, int resourceID, int resourceInstance, int &value, tout_t aTimeout)
 {
    ME310::return_t ret;
-   int i = 0;
-	memset(mBuffer,0,ME310_BUFFSIZE);
-	snprintf((char*)mBuffer, ME310_BUFFSIZE-1,F("AT#LWM2MR=%d,%d,%d,%d,%d"), agent,objID,instanceID,resourceID, resourceInstance);
-	ret = send_wait((char*)mBuffer,OK_STRING, aTimeout);
-   if(ret == RETURN_VALID)
+   const char *str = read_lwm2m_value(agent, objID, instanceID, resourceID, resourceInstance, ret, aTimeout);
+   if(str != NULL)
    {
-      while(buffer_cstr(i) != NULL)
+      char *end;
+      long result = strtol(str, &end, 10);
+      if(end == str)
       {
-         String retValue = buffer_cstr(i);
-         if(retValue.startsWith("#LWM2MR:"))
-         {
-            int pos = retValue.indexOf(":");
-            value = atoi(retValue.substring(pos +1).c_str());
-            ret = RETURN_VALID;
-            break;
-         }
-         i++;
+         return RETURN_ERROR;
       }
+      value = result;
    }
    return ret;
 }
@@ -6276,6 +7166,192 @@ ME310::return_t ME310::LWM2M_read_resource_string(int agent, int objID, int inst
 	return send_wait((char*)mBuffer,OK_STRING, aTimeout);
 }
 
+/*! \brief Implements the AT#LWM2MR command and parses the float value
+/*! \details
+The answer is parsed in place in the class buffer, no memory is allocated.
+ * \param agent identifies the agent LWM2M
+ * \param objID identifies the object LWM2M
+ * \param instanceID identifies the instance of the object
+ * \param resourceID identifies the resource of the object
+ * \param resourceInstance identifies the instance of the resource
+ * \param value filled with the resource value
+ * \param aTimeout specifies the timeout
+ * \return return code, RETURN_ERROR if the answer does not contain a float value
+*/
+ME310::return_t ME310::LWM2M_read_resource_float(int agent, int objID, int instanceID, int resourceID, int resourceInstance, float &value, tout_t aTimeout)
+{
+   ME310::return_t ret;
+   const char *str = read_lwm2m_value(agent, objID, instanceID, resourceID, resourceInstance, ret, aTimeout);
+   if(str != NULL)
+   {
+      char *end;
+      double result = strtod(str, &end);
+      if(end == str)
+      {
+         return RETURN_ERROR;
+      }
+      value = result;
+   }
+   return ret;
+}
+
+/*! \brief Implements the AT#LWM2MR command and copies the string value
+/*! \details
+The answer is parsed in place in the class buffer, no memory is allocated. Enclosing quotes are removed,
+a value longer than the buffer is truncated.
+ * \param agent identifies the agent LWM2M
+ * \param objID identifies the object LWM2M
+ * \param instanceID identifies the instance of the object
+ * \param resourceID identifies the resource of the object
+ * \param resourceInstance identifies the instance of the resource
+ * \param value buffer filled with the null terminated resource value
+ * \param size size of the buffer
+ * \param aTimeout specifies the timeout
+ * \return return code
+*/
+ME310::return_t ME310::LWM2M_read_resource_string(int agent, int objID, int instanceID, int resourceID, int resourceInstance, char *value, size_t size, tout_t aTimeout)
+{
+   ME310::return_t ret;
+   if(value == NULL || size == 0)
+   {
+      return RETURN_ERROR;
+   }
+   const char *str = read_lwm2m_value(agent, objID, instanceID, resourceID, resourceInstance, ret, aTimeout);
+   if(str != NULL)
+   {
+      size_t len = strlen(str);
+      if(len >= 2 && str[0] == '"' && str[len - 1] == '"')
+      {
+         str++;
+         len -= 2;
+      }
+      if(len >= size)
+      {
+         len = size - 1;
+      }
+      memcpy(value, str, len);
+      value[len] = 0;
+   }
+   return ret;
+}
+
+/*! \brief Implements the AT#LWM2MR command and decodes the opaque value
+/*! \details
+The opaque value is reported as a string of hexadecimal digits, it is decoded in place, no memory is allocated.
+ * \param agent identifies the agent LWM2M
+ * \param objID identifies the object LWM2M
+ * \param instanceID identifies the instance of the object
+ * \param resourceID identifies the resource of the object
+ * \param resourceInstance identifies the instance of the resource
+ * \param value buffer filled with the resource value
+ * \param size size of the buffer
+ * \param len filled with the number of bytes of the value
+ * \param aTimeout specifies the timeout
+ * \return return code, RETURN_ERROR if the value is not hexadecimal or does not fit in the buffer
+*/
+ME310::return_t ME310::LWM2M_read_resource_opaque(int agent, int objID, int instanceID, int resourceID, int resourceInstance, uint8_t *value, size_t size, size_t &len, tout_t aTimeout)
+{
+   ME310::return_t ret;
+   len = 0;
+   const char *str = read_lwm2m_value(agent, objID, instanceID, resourceID, resourceInstance, ret, aTimeout);
+   if(str == NULL)
+   {
+      return ret;
+   }
+   if(*str == '"')
+   {
+      str++;
+   }
+   while(*str != 0 && *str != '"')
+   {
+      int nibbles[2];
+      for(int i = 0; i < 2; i++)
+      {
+         char c = *str++;
+         if(c >= '0' && c <= '9') nibbles[i] = c - '0';
+         else if(c >= 'A' && c <= 'F') nibbles[i] = c - 'A' + 10;
+         else if(c >= 'a' && c <= 'f') nibbles[i] = c - 'a' + 10;
+         else return RETURN_ERROR;
+      }
+      if(len >= size)
+      {
+         return RETURN_ERROR;
+      }
+      value[len++] = (nibbles[0] << 4) | nibbles[1];
+   }
+   return ret;
+}
+
+/*! \brief Implements the AT#LWM2MR command and parses the time value
+/*! \details
+The answer is parsed in place in the class buffer, no memory is allocated.
+ * \param agent identifies the agent LWM2M
+ * \param objID identifies the object LWM2M
+ * \param instanceID identifies the instance of the object
+ * \param resourceID identifies the resource of the object
+ * \param resourceInstance identifies the instance of the resource
+ * \param value filled with the seconds since Jan 1st, 1970 in the UTC time zone
+ * \param aTimeout specifies the timeout
+ * \return return code, RETURN_ERROR if the answer does not contain a time value
+*/
+ME310::return_t ME310::LWM2M_read_resource_time(int agent, int objID, int instanceID, int resourceID, int resourceInstance, uint32_t &value, tout_t aTimeout)
+{
+   ME310::return_t ret;
+   const char *str = read_lwm2m_value(agent, objID, instanceID, resourceID, resourceInstance, ret, aTimeout);
+   if(str != NULL)
+   {
+      char *end;
+      unsigned long result = strtoul(str, &end, 10);
+      if(end == str)
+      {
+         return RETURN_ERROR;
+      }
+      value = result;
+   }
+   return ret;
+}
+
+/*! \brief Implements the AT#LWM2MR command and searches the value in the answer
+/*! \details
+The answer lines are scanned once in the class buffer, no memory is allocated.
+ * \param agent identifies the agent LWM2M
+ * \param objID identifies the object LWM2M
+ * \param instanceID identifies the instance of the object
+ * \param resourceID identifies the resource of the object
+ * \param resourceInstance identifies the instance of the resource
+ * \param ret filled with the return code, RETURN_ERROR if the answer does not contain #LWM2MR
+ * \param aTimeout specifies the timeout
+ * \return pointer to the value in the class buffer, NULL on error
+*/
+const char *ME310::read_lwm2m_value(int agent, int objID, int instanceID, int resourceID, int resourceInstance, return_t &ret, tout_t aTimeout)
+{
+   const char *LWM2MR_STRING = "#LWM2MR:";
+   memset(mBuffer,0,ME310_BUFFSIZE);
+   snprintf((char*)mBuffer, ME310_BUFFSIZE-1,F("AT#LWM2MR=%d,%d,%d,%d,%d"), agent, objID, instanceID, resourceID, resourceInstance);
+   ret = send_wait((char*)mBuffer,OK_STRING, aTimeout);
+   if(ret != RETURN_VALID)
+   {
+      return NULL;
+   }
+   const char *line = (const char *)mBuffer;
+   const char *end = (const char *)mBuffer + mBuffLen;
+   while(line < end)
+   {
+      if(strncmp(line, LWM2MR_STRING, strlen(LWM2MR_STRING)) == 0)
+      {
+         line += strlen(LWM2MR_STRING);
+         while(*line == ' ')
+         {
+            line++;
+         }
+         return line;
+      }
+      line += strlen(line) + 1;
+   }
+   ret = RETURN_ERROR;
+   return NULL;
+}
+
 /*! \brief Implements the AT#LWM2MEXIST command and wait OK answer
 /*! \details
 This function allows the end-user to query the module in order to discover if a given agent exist.
@@ -6419,6 +7495,51 @@ ME310::return_t ME310::LWM2M_send_ACK(tout_t aTimeout)
 	snprintf((char*)mBuffer, ME310_BUFFSIZE-1,F("AT#LWM2MACK=1"));
 	return send_wait((char*)mBuffer,OK_STRING, aTimeout);
 }
+
+/*! \brief Processes the LWM2M events reported by unsolicited codes
+/*! \details
+Events reported by #LWM2MRING and #LWM2MEVT unsolicited codes are queued by the driver. This function
+delivers each queued event to on_lwm2m_event() and, if enabled with LWM2M_set_auto_ACK(), acknowledges
+write and execute events with AT#LWM2MACK. Events received meanwhile are processed in the same call.
+When the queue is full, write and execute events are kept in place of the other events, see
+LWM2M_dropped_events() and LWM2M_dropped_ACKs().
+ * \param aTimeout specifies the timeout of each acknowledge
+ * \return return code of the first failed acknowledge, RETURN_VALID otherwise
+*/
+ME310::return_t ME310::LWM2M_process_events(tout_t aTimeout)
+{
+   ME310::return_t ret = RETURN_VALID;
+   while(mLwm2mEventCount > 0)
+   {
+      lwm2m_event_t event = mLwm2mEvents[mLwm2mEventHead];
+      mLwm2mEventHead = (mLwm2mEventHead + 1) % ME310_LWM2M_EVENT_QUEUE_SIZE;
+      mLwm2mEventCount--;
+
+      on_lwm2m_event(event);
+      if(mLwm2mAutoAck && (event.op == LWM2M_OP_WRITE || event.op == LWM2M_OP_EXECUTE))
+      {
+         ME310::return_t rc = LWM2M_send_ACK(aTimeout);
+         if(rc != RETURN_VALID && ret == RETURN_VALID)
+         {
+            ret = rc;
+         }
+      }
+   }
+   return ret;
+}
+
+/*! \brief Callback function on LWM2M event processed by LWM2M_process_events
+/*! \details
+The default implementation dispatches the event to the dispatcher set with LWM2M_set_dispatcher(), if any.
+ * \param event event reported by the module
+*/
+void ME310::on_lwm2m_event(const lwm2m_event_t &event)
+{
+   if(mLwm2mDispatcher != nullptr)
+   {
+      mLwm2mDispatcher->dispatch(event);
+   }
+}
 /*! \brief Implements the AT#LWM2MCFG command and wait OK answer
 /*! \details
 This function allows the user to configure a parameter specified by parameter ID.
@@ -6632,6 +7753,86 @@ ME310::return_t ME310::LWM2M_get_object_resource(int agentInstanceID, int object
 	return send_wait((char*)mBuffer, 0, OK_STRING, aTimeout);
 }
 
+//! \brief Implements the AT#LWM2MOBJGET command and parses the listing in a tree
+/*! \details
+The listing is read line by line in the class memory buffer and parsed in a single pass once the OK
+answer is received, so all the instances and resources of the object are available with one command.
+ * \param agentInstanceID selects the lwm2m instance.
+ * \param objectID selects the object identifier of the URI.
+ * \param tree receives the instances and resources of the listing
+ * \param objectInstanceID selects object instance identifier, -1 for all the instances
+ * \param resourceID selects resource identifier, -1 for all the resources of the instance
+ * \param aTimeout timeout in ms waiting for each line
+ * \return RETURN_ERROR if the listing does not fit the class memory buffer or the tree arena
+*/
+ME310::return_t ME310::LWM2M_get_object_tree(int agentInstanceID, int objectID, LWM2MObjectTree &tree, int objectInstanceID, int resourceID, tout_t aTimeout)
+{
+   char command[ME310_BUFFCOMMANDSIZE];
+   if(objectInstanceID < 0)
+   {
+      snprintf(command, ME310_BUFFCOMMANDSIZE-1, F("AT#LWM2MOBJGET=%d,%d"), agentInstanceID, objectID);
+   }
+   else if(resourceID < 0)
+   {
+      snprintf(command, ME310_BUFFCOMMANDSIZE-1, F("AT#LWM2MOBJGET=%d,%d,%d"), agentInstanceID, objectID, objectInstanceID);
+   }
+   else
+   {
+      snprintf(command, ME310_BUFFCOMMANDSIZE-1, F("AT#LWM2MOBJGET=%d,%d,%d,%d"), agentInstanceID, objectID, objectInstanceID, resourceID);
+   }
+   tree.clear();
+   send(command, F("\r"));
+   on_receive();
+   mBuffLen = 0;
+   mpBuffer = mBuffer;
+   memset(mBuffer, 0, ME310_BUFFSIZE);
+
+   /* lines are appended to the buffer, the ones that do not fit are read and dropped */
+   char discard[ME310_BUFFCOMMANDSIZE];
+   bool overflow = false;
+   for(;;)
+   {
+      size_t available = ME310_BUFFSIZE - mBuffLen - 1;
+      char *line = (available > 1) ? (char*)mBuffer + mBuffLen : discard;
+      int len = read_raw_line(line, (line == discard) ? sizeof(discard) : available, aTimeout);
+      if(len < 0)
+      {
+         mBuffer[mBuffLen] = 0;
+         on_timeout();
+         return RETURN_TOUT;
+      }
+      if(str_equal(line, OK_STRING))
+      {
+         break;
+      }
+      if(str_equal(line, ERROR_STRING) || strncmp(line, CME_ERROR_STRING, strlen(CME_ERROR_STRING)) == 0)
+      {
+         on_error(line);
+         return RETURN_ERROR;
+      }
+      if(len == 0 || process_unsolicited(line))
+      {
+         continue;
+      }
+      if(line == discard || (size_t)len + 1 >= available)
+      {
+         overflow = true;
+      }
+      else
+      {
+         mBuffLen += len;
+         mBuffer[mBuffLen++] = '\n';
+      }
+   }
+   mBuffer[mBuffLen] = 0;
+   on_valid(OK_STRING);
+   if(overflow || !tree.parse((const char*)mBuffer))
+   {
+      return RETURN_ERROR;
+   }
+   return RETURN_VALID;
+}
+
 /*! \brief Implements the AT#LWM2MSTAT command and wait OK answer
 /*! \details
 This function sends a query about the status to the Telit LwM2M client.
@@ -6733,6 +7934,12 @@ ME310::return_t ME310::m2m_chdir(const char *path, tout_t aTimeout)
 {
    memset(mBuffer, 0, ME310_BUFFSIZE);
    snprintf((char *)mBuffer, ME310_BUFFSIZE-1, F("AT#M2MCHDIR=\"%s\""), path);
+   /* relative names change meaning */
+   mM2MSizeName[0] = 0;
+   if(mM2MIndex != nullptr)
+   {
+      mM2MIndex->clear();
+   }
    return send_wait((char*)mBuffer, OK_STRING, aTimeout);
 }
 
@@ -6747,6 +7954,7 @@ ME310::return_t ME310::m2m_mkdir(const char *directory_name, ME310::tout_t aTime
 {
    memset(mBuffer, 0, ME310_BUFFSIZE);
    snprintf((char *)mBuffer, ME310_BUFFSIZE-1, F("AT#M2MMKDIR=\"%s\""), directory_name);
+   invalidate_m2m(directory_name);
    return send_wait((char*)mBuffer, OK_STRING, aTimeout);
 }
 
@@ -6775,6 +7983,7 @@ ME310::return_t ME310::m2m_rmdir(const char *directory_name, tout_t aTimeout)
 {
    memset(mBuffer, 0, ME310_BUFFSIZE);
    snprintf((char *)mBuffer, ME310_BUFFSIZE-1, F("AT#M2MRMDIR=\"%s\""), directory_name);
+   invalidate_m2m(directory_name, true);
    return send_wait((char*)mBuffer, OK_STRING, aTimeout);
 }
 
@@ -6828,50 +8037,139 @@ ME310::return_t ME310::m2m_delete(const char *file_name, tout_t aTimeout)
 {
    memset(mBuffer, 0, ME310_BUFFSIZE);
    snprintf((char *)mBuffer, ME310_BUFFSIZE-1, F("AT#M2MDEL=\"%s\""), file_name);
+   invalidate_m2m(file_name);
    return send_wait((char*)mBuffer, OK_STRING, aTimeout);
 }
 
 //! \brief Implements the AT\#M2MWRITE command and waits for OK answer
 /*! \details
-This command stores a file in the file system.
+This command stores a file in the file system. The data is written to the serial after the >>> prompt
+without being copied in the class memory buffer, so its size is not limited by ME310_BUFFSIZE.
  * \param file_name    file name
  * \param size    file size
  * \param binToMod    if <file_name> is provided as filename with ".bin" extension, using <binToMod> set to 1, force the file to be automatically written on "/mod" folder whichever is the current directory
+ * \param data    file content
  * \param aTimeout timeout in ms
  * \return return code
  */
 ME310::return_t ME310::m2m_write_file(const char *file_name, int size, int binToMod, char* data, tout_t aTimeout)
+{
+   if(data == NULL || size < 0)
+   {
+      return RETURN_ERROR;
+   }
+   return m2m_write_file(file_name, size, binToMod, copy_source, &data, NULL, aTimeout);
+}
+
+//! \brief Implements the AT\#M2MWRITE command with the data given by a source
+/*! \details
+After the >>> prompt the source is called to fill the class memory buffer, up to ME310_BUFFSIZE-1 bytes at a
+time, and each piece is written to the serial until size bytes are sent, so files larger than the buffer
+can be written without being staged in RAM.\n
+If the source returns 0 before size bytes, the file is completed with zeros, because the module waits for
+all the declared bytes, and RETURN_ERROR is returned: the incomplete file should be deleted.\n
+The report gives the number of bytes and the CRC-32 of the data given by the source, it can be compared with
+the CRC-32 of the file read back with m2m_read_file().
+ * \param file_name    file name
+ * \param size    file size
+ * \param binToMod    if <file_name> is provided as filename with ".bin" extension, using <binToMod> set to 1, force the file to be automatically written on "/mod" folder whichever is the current directory
+ * \param source    function filling the file content
+ * \param context    pointer passed back to the source
+ * \param report    receives length and checksum of the data given by the source, may be NULL
+ * \param aTimeout timeout in ms waiting for the prompt and for the final answer
+ * \return return code
+ */
+ME310::return_t ME310::m2m_write_file(const char *file_name, int size, int binToMod, m2m_source_t source, void *context, m2m_transfer_t *report, tout_t aTimeout)
 {
    ME310::return_t ret;
-   SET_BIT_MASK(_option, _M2MWRITE_BIT);
+   m2m_transfer_t transfer = {0, 0};
+   if(report != NULL)
+   {
+      *report = transfer;
+   }
+   if(source == NULL || size < 0)
+   {
+      return RETURN_ERROR;
+   }
+   invalidate_m2m(file_name);
+   if(binToMod != 0)
+   {
+      invalidate_m2m("/mod/", true);
+   }
    memset(mBuffer, 0, ME310_BUFFSIZE);
-   if(ME310_BUFFSIZE-1 < size)
+   if(binToMod != 0)
    {
-      ret = RETURN_ERROR;
+      snprintf((char *)mBuffer, ME310_BUFFSIZE-1, F("AT#M2MWRITE=\"%s\",%d,%d"), file_name, size, binToMod);
    }
    else
    {
-      if(binToMod != 0)
+      snprintf((char *)mBuffer, ME310_BUFFSIZE-1, F("AT#M2MWRITE=\"%s\",%d"), file_name, size);
+   }
+   ret = send_wait((char*)mBuffer, SEQUENCE_STRING, aTimeout);
+   if(ret != RETURN_VALID)
+   {
+      return ret;
+   }
+
+   bool complete = true;
+   uint32_t crc = 0;
+   int sent = 0;
+   while(sent < size)
+   {
+      size_t chunk = size - sent;
+      if(chunk > ME310_BUFFSIZE - 1)
       {
-         snprintf((char *)mBuffer, ME310_BUFFSIZE-1, F("AT#M2MWRITE=\"%s\",%d,%d"), file_name, size, binToMod);
+         chunk = ME310_BUFFSIZE - 1;
       }
-      else
+      size_t filled = complete ? source(mBuffer, chunk, context) : 0;
+      if(filled > chunk)
       {
-         snprintf((char *)mBuffer, ME310_BUFFSIZE-1, F("AT#M2MWRITE=\"%s\",%d"), file_name, size);
+         filled = chunk;
       }
-      ret =  send_wait((char*)mBuffer, SEQUENCE_STRING, aTimeout);
-      if ((ret == RETURN_VALID))
+      if(filled == 0)
       {
-         memset(mBuffer, 0, ME310_BUFFSIZE);
-         memcpy(mBuffer, data, size);
-         ret =  send_wait((char*)mBuffer, size, OK_STRING, NULL, aTimeout);
+         /* source exhausted: pad so the module ends the command */
+         complete = false;
+         memset(mBuffer, 0, chunk);
+         filled = chunk;
+      }
+      else
+      {
+         crc = crc32(crc, mBuffer, filled);
+         transfer.len += filled;
       }
+      write_payload(mBuffer, filled);
+      sent += filled;
+   }
+   transfer.checksum = crc;
+   if(report != NULL)
+   {
+      *report = transfer;
+   }
+   ret = wait_for(OK_STRING, aTimeout);
+   if(ret == RETURN_VALID && !complete)
+   {
+      ret = RETURN_ERROR;
    }
-   UNSET_BIT_MASK(_option, _M2MWRITE_BIT);
    return ret;
 }
 
-//! \brief Implements the AT\#M2MLIST command and waits for OK answer
+//! \brief Source of m2m_write_file() reading from memory
+/*!
+ * \param data    buffer to be filled
+ * \param len     number of bytes to fill
+ * \param context    pointer to the char pointer of the data, moved after the copied bytes
+ * \return number of bytes filled
+ */
+size_t ME310::copy_source(uint8_t *data, size_t len, void *context)
+{
+   char **src = (char**)context;
+   memcpy(data, *src, len);
+   *src += len;
+   return len;
+}
+
+//! \brief Implements the AT\#M2MLIST command and waits for OK answer
 /*! \details
 This command lists the contents of a folder in the File System.
  * \param path    directory name
@@ -6906,11 +8204,9 @@ This command reports the content of a file stored in the File System.
 ME310::return_t ME310::m2m_read(const char *file_name, tout_t aTimeout)
 {
    ME310::return_t ret;
+   int fileSize;
+   m2m_file_size(file_name, fileSize, aTimeout);
    memset(mBuffer, 0, ME310_BUFFSIZE);
-   PathParsing strPar((char*)file_name);
-   m2m_list(strPar.getPath());
-   char* tmp_data_raw = (char*)buffer_cstr_raw();
-   int fileSize = strPar.getFileSize(tmp_data_raw);
    SET_BIT_MASK(_option, _M2MREAD_BIT);
    if(fileSize > ME310_BUFFSIZE-1)
    {
@@ -6925,6 +8221,235 @@ ME310::return_t ME310::m2m_read(const char *file_name, tout_t aTimeout)
    return ret;
 }
 
+//! \brief Implements the AT\#M2MREAD command and delivers the file in chunks
+/*! \details
+The file content is read from the serial in chunks of up to ME310_BUFFSIZE-1 bytes, each one passed to the
+sink through the class memory buffer, so files of any size can be read. The size is needed to find the end
+of the content: if it is not given, it is taken from m2m_file_size(), that lists the directory only once for
+each file. If the sink returns false the remaining content is read and dropped.
+ * \param file_name    file name
+ * \param sink    function receiving the chunks, may be NULL
+ * \param context    pointer passed back to the sink
+ * \param size    file size, -1 to get it from m2m_file_size()
+ * \param aTimeout timeout in ms waiting for each chunk
+ * \return return code
+ */
+ME310::return_t ME310::m2m_read_file(const char *file_name, m2m_sink_t sink, void *context, int size, tout_t aTimeout)
+{
+   return_t ret;
+   if(size < 0 && (ret = m2m_file_size(file_name, size, aTimeout)) != RETURN_VALID)
+   {
+      return ret;
+   }
+   char command[ME310_BUFFCOMMANDSIZE + ME310_M2M_NAME_SIZE];
+   snprintf(command, sizeof(command)-1, F("AT#M2MREAD=\"%s\""), file_name);
+   send(command, F("\r"));
+   on_receive();
+   mBuffLen = 0;
+   mpBuffer = mBuffer;
+
+   /* the content follows the <<< sequence, lines before it are the echo, errors or unsolicited codes */
+   char line[ME310_BUFFCOMMANDSIZE];
+   size_t lineLen = 0;
+   int marks = 0;
+   unsigned long waited = 0;
+   while(marks < 3)
+   {
+      char c;
+      if(mSerial.readBytes(&c, 1) != 1)
+      {
+         waited += mSerial.getTimeout();
+         if(waited >= aTimeout)
+         {
+            on_timeout();
+            return RETURN_TOUT;
+         }
+         continue;
+      }
+      if(c == '<')
+      {
+         marks++;
+         continue;
+      }
+      marks = 0;
+      if(c != '\n')
+      {
+         if(c != '\r' && lineLen < sizeof(line) - 1)
+         {
+            line[lineLen++] = c;
+         }
+         continue;
+      }
+      line[lineLen] = 0;
+      if(str_equal(line, ERROR_STRING) || strncmp(line, CME_ERROR_STRING, strlen(CME_ERROR_STRING)) == 0)
+      {
+         on_error(line);
+         return RETURN_ERROR;
+      }
+      if(lineLen > 0)
+      {
+         process_unsolicited(line);
+      }
+      lineLen = 0;
+   }
+
+   bool deliver = (sink != NULL);
+   int received = 0;
+   waited = 0;
+   while(received < size)
+   {
+      size_t chunk = size - received;
+      if(chunk > ME310_BUFFSIZE - 1)
+      {
+         chunk = ME310_BUFFSIZE - 1;
+      }
+      int bytesRead = mSerial.readBytes(mBuffer, chunk);
+      if(bytesRead <= 0)
+      {
+         waited += mSerial.getTimeout();
+         if(waited >= aTimeout)
+         {
+            on_timeout();
+            return RETURN_TOUT;
+         }
+         continue;
+      }
+      waited = 0;
+      received += bytesRead;
+      if(deliver)
+      {
+         deliver = sink(mBuffer, bytesRead, context);
+      }
+   }
+
+   /* final result code */
+   int len;
+   do
+   {
+      len = read_raw_line(line, sizeof(line), aTimeout);
+      if(len < 0)
+      {
+         on_timeout();
+         return RETURN_TOUT;
+      }
+      if(str_equal(line, ERROR_STRING) || strncmp(line, CME_ERROR_STRING, strlen(CME_ERROR_STRING)) == 0)
+      {
+         on_error(line);
+         return RETURN_ERROR;
+      }
+      if(len > 0 && !str_equal(line, OK_STRING))
+      {
+         process_unsolicited(line);
+      }
+   }while(!str_equal(line, OK_STRING));
+   on_valid(line);
+   return RETURN_VALID;
+}
+
+//! \brief Gets the size of a file of the M2M file system
+/*! \details
+If an index is set with m2m_set_index(), the size is looked up in the index and the directory is listed
+only if it is not indexed yet. Otherwise the directory is listed with AT\#M2MLIST and the size of the last
+file found is cached. In both cases the file name is compared with the whole name of each entry, and the
+cached data is invalidated when the file system is changed through the driver.
+ * \param file_name    file name, with path
+ * \param size    receives the file size, -1 if the file is not found
+ * \param aTimeout timeout in ms waiting for each line
+ * \return RETURN_ERROR if the file is not found
+ */
+ME310::return_t ME310::m2m_file_size(const char *file_name, int &size, tout_t aTimeout)
+{
+   size = -1;
+   if(file_name == NULL || strlen(file_name) >= ME310_M2M_NAME_SIZE)
+   {
+      return RETURN_ERROR;
+   }
+   if(mM2MIndex != nullptr)
+   {
+      M2MIndex::lookup_t found = mM2MIndex->find(file_name, size);
+      if(found != M2MIndex::M2M_INDEX_UNKNOWN)
+      {
+         return (found == M2MIndex::M2M_INDEX_FOUND && size >= 0) ? RETURN_VALID : RETURN_ERROR;
+      }
+   }
+   else if(mM2MSizeName[0] != 0 && strcmp(mM2MSizeName, file_name) == 0)
+   {
+      size = mM2MSize;
+      return RETURN_VALID;
+   }
+
+   char path[ME310_M2M_NAME_SIZE];
+   const char *name = M2MIndex::split(file_name, path, sizeof(path));
+   bool found;
+   return_t ret = list_m2m_directory(path, name, found, size, aTimeout);
+   if(ret != RETURN_VALID)
+   {
+      return ret;
+   }
+   if(!found || size < 0)
+   {
+      size = -1;
+      return RETURN_ERROR;
+   }
+   if(mM2MIndex == nullptr)
+   {
+      strcpy(mM2MSizeName, file_name);
+      mM2MSize = size;
+   }
+   return RETURN_VALID;
+}
+
+//! \brief Checks if a file or directory exists in the M2M file system
+/*! \details
+If an index is set with m2m_set_index(), the directory is listed only if it is not indexed yet.
+ * \param file_name    file or directory name, with path
+ * \param aTimeout timeout in ms waiting for each line
+ * \return RETURN_VALID if the entry exists, RETURN_ERROR if it does not
+ */
+ME310::return_t ME310::m2m_file_exists(const char *file_name, tout_t aTimeout)
+{
+   int size;
+   if(file_name == NULL || strlen(file_name) >= ME310_M2M_NAME_SIZE)
+   {
+      return RETURN_ERROR;
+   }
+   if(mM2MIndex != nullptr)
+   {
+      M2MIndex::lookup_t found = mM2MIndex->find(file_name, size);
+      if(found != M2MIndex::M2M_INDEX_UNKNOWN)
+      {
+         return (found == M2MIndex::M2M_INDEX_FOUND) ? RETURN_VALID : RETURN_ERROR;
+      }
+   }
+   char path[ME310_M2M_NAME_SIZE];
+   const char *name = M2MIndex::split(file_name, path, sizeof(path));
+   bool found;
+   return_t ret = list_m2m_directory(path, name, found, size, aTimeout);
+   if(ret == RETURN_VALID && !found)
+   {
+      ret = RETURN_ERROR;
+   }
+   return ret;
+}
+
+//! \brief Lists a directory of the M2M file system in the index
+/*! \details
+The index set with m2m_set_index() is filled with the entries of the directory, replacing the previous ones.
+ * \param path    directory path
+ * \param aTimeout timeout in ms waiting for each line
+ * \return RETURN_ERROR if no index is set
+ */
+ME310::return_t ME310::m2m_index_directory(const char *path, tout_t aTimeout)
+{
+   if(mM2MIndex == nullptr || path == NULL || strlen(path) >= ME310_M2M_NAME_SIZE)
+   {
+      return RETURN_ERROR;
+   }
+   bool found;
+   int size;
+   return list_m2m_directory(path, NULL, found, size, aTimeout);
+}
+
 //! \brief Implements the AT\#M2MRAM command and waits for OK answer
 /*! \details
 The execution command returns information on RAM memory for AppZone applications.
@@ -7114,6 +8639,60 @@ ME310::return_t ME310::mqtt_publish(int instanceNumber, const char *topic, int r
    return send_wait((char*)mBuffer, OK_STRING, aTimeout);
 }
 
+//! \brief Implements the AT\#MQPUBSEXT command and waits for OK answer
+/*! \details
+This command publishes a message of any content to the specified MQTT topic. The payload is sent as raw
+bytes after the prompt, so it can contain quotes and NUL characters and is not limited by the class buffer.\n
+The module answers OK when the message has been delivered according to its QoS: for QoS 1 and 2 the time
+elapsed until the answer is recorded as delivery latency, see mqtt_publish_statistics().
+ * \param instanceNumber    selects the client instance
+ * \param topic    name of the topic
+ * \param retain    specifies if the broker must retain this message or not
+ * \param qos    specifies the Quality of Service of this message
+ * \param payload    message to publish on the topic
+ * \param len    length of the message in bytes
+ * \param aTimeout timeout in ms
+ * \return return code
+ */
+ME310::return_t ME310::mqtt_publish_binary(int instanceNumber, const char *topic, int retain, int qos, const uint8_t *payload, int len, tout_t aTimeout)
+{
+   ME310::return_t ret;
+   if(payload == NULL || len <= 0)
+   {
+      return RETURN_ERROR;
+   }
+   unsigned long start = millis();
+   memset(mBuffer, 0, ME310_BUFFSIZE);
+   snprintf((char *)mBuffer, ME310_BUFFSIZE-1, F("AT#MQPUBSEXT=%d,\"%s\",%d,%d,%d"), instanceNumber, topic, retain, qos, len);
+   ret = send_wait((char*)mBuffer, WAIT_DATA_STRING, aTimeout);
+   if(ret == RETURN_VALID)
+   {
+      write_payload(payload, len);
+      ret = wait_for(OK_STRING, aTimeout);
+   }
+   if(ret == RETURN_VALID)
+   {
+      mMqttPublishStats.published++;
+      mMqttPublishStats.bytes += len;
+      if(qos > 0)
+      {
+         uint32_t latency = millis() - start;
+         mMqttPublishStats.qos_acknowledged++;
+         mMqttPublishStats.last_latency = latency;
+         mMqttPublishStats.total_latency += latency;
+         if(latency > mMqttPublishStats.max_latency)
+         {
+            mMqttPublishStats.max_latency = latency;
+         }
+      }
+   }
+   else
+   {
+      mMqttPublishStats.failed++;
+   }
+   return ret;
+}
+
 //! \brief Implements the AT\#MQREAD command and waits for OK answer
 /*! \details
 This command reads the message payload from the queue slot provided.
@@ -7129,6 +8708,231 @@ ME310::return_t ME310::mqtt_read(int instanceNumber, int mId, tout_t aTimeout)
    return send_wait((char*)mBuffer, 0, OK_STRING, aTimeout);
 }
 
+//! \brief Implements the AT\#MQREAD command and parses the message in place
+/*! \details
+This command reads the message payload from the queue slot provided. The answer is read by length, so the
+payload can contain any octet. Topic and payload are stored in the class memory buffer.
+ * \param instanceNumber    selects the client instance
+ * \param mId    message slot Id to be read. The read operation will free the slot resource
+ * \param message    filled with topic and payload of the message
+ * \param aTimeout timeout in ms
+ * \return return code
+ */
+ME310::return_t ME310::mqtt_read_message(int instanceNumber, int mId, mqtt_message_t &message, tout_t aTimeout)
+{
+   const char *MQREAD_STRING = "#MQREAD: ";
+   char command[ME310_BUFFCOMMANDSIZE];
+   message.instance = instanceNumber;
+   message.mId = mId;
+   message.topic = NULL;
+   message.payload = NULL;
+   message.len = 0;
+
+   snprintf(command, ME310_BUFFCOMMANDSIZE-1, F("AT#MQREAD=%d,%d"), instanceNumber, mId);
+   send(command, F("\r"));
+   on_receive();
+   mBuffLen = 0;
+   mpBuffer = mBuffer;
+   memset(mBuffer, 0, ME310_BUFFSIZE);
+
+   char *line = (char*)mBuffer;
+   int len;
+   do
+   {
+      len = read_raw_line(line, ME310_BUFFSIZE, aTimeout);
+      if(len < 0)
+      {
+         on_timeout();
+         return RETURN_TOUT;
+      }
+      if(str_equal(line, ERROR_STRING) || strncmp(line, CME_ERROR_STRING, strlen(CME_ERROR_STRING)) == 0)
+      {
+         on_error(line);
+         return RETURN_ERROR;
+      }
+      if(len > 0 && strncmp(line, MQREAD_STRING, strlen(MQREAD_STRING)) != 0)
+      {
+         process_unsolicited(line);
+      }
+   }while(strncmp(line, MQREAD_STRING, strlen(MQREAD_STRING)) != 0);
+
+   /* #MQREAD: <instanceNumber>,<topic>,<len> */
+   char *firstComma = strchr(line, ',');
+   char *lastComma = strrchr(line, ',');
+   if(firstComma == NULL || lastComma == firstComma)
+   {
+      return RETURN_ERROR;
+   }
+   *lastComma = 0;
+   int payloadLen = atoi(lastComma + 1);
+   char *topic = firstComma + 1;
+   if(*topic == '"' && lastComma[-1] == '"')
+   {
+      lastComma[-1] = 0;
+      topic++;
+   }
+   uint8_t *payload = (uint8_t*)lastComma + 1;
+   size_t available = ME310_BUFFSIZE - (payload - mBuffer) - 1;
+
+   /* payload follows the <<< sequence */
+   char sequence[3];
+   if(mSerial.readBytes(sequence, 3) != 3 || strncmp(sequence, "<<<", 3) != 0)
+   {
+      on_timeout();
+      return RETURN_TOUT;
+   }
+   int received = 0;
+   while(received < payloadLen)
+   {
+      size_t chunk = payloadLen - received;
+      uint8_t *dst = payload + received;
+      if(received >= (int)available)
+      {
+         /* does not fit in the buffer: discard the tail to keep the answer in sync */
+         dst = payload + available;
+         chunk = 1;
+      }
+      else if(chunk > available - received)
+      {
+         chunk = available - received;
+      }
+      int bytesRead = mSerial.readBytes(dst, chunk);
+      if(bytesRead <= 0)
+      {
+         on_timeout();
+         return RETURN_TOUT;
+      }
+      received += bytesRead;
+   }
+   if(payloadLen > (int)available)
+   {
+      payloadLen = available;
+   }
+   payload[payloadLen] = 0;
+   mBuffLen = (payload - mBuffer) + payloadLen + 1;
+
+   message.topic = topic;
+   message.payload = payload;
+   message.len = payloadLen;
+
+   /* final result code, read after the payload so it does not overwrite it */
+   char tail[ME310_BUFFCOMMANDSIZE];
+   do
+   {
+      len = read_raw_line(tail, ME310_BUFFCOMMANDSIZE, aTimeout);
+      if(len < 0)
+      {
+         on_timeout();
+         return RETURN_TOUT;
+      }
+      if(str_equal(tail, ERROR_STRING) || strncmp(tail, CME_ERROR_STRING, strlen(CME_ERROR_STRING)) == 0)
+      {
+         on_error(tail);
+         return RETURN_ERROR;
+      }
+      if(len > 0 && !str_equal(tail, OK_STRING))
+      {
+         process_unsolicited(tail);
+      }
+   }while(!str_equal(tail, OK_STRING));
+   on_valid(tail);
+   return RETURN_VALID;
+}
+
+//! \brief Reads the MQTT messages notified by \#MQRING
+/*! \details
+Messages notified by \#MQRING unsolicited codes are queued by the driver. This method drains the queue
+with back-to-back AT\#MQREAD commands and delivers each message to on_mqtt_message().
+Notifications received while reading are queued and drained in the same call. A notification whose read
+times out stays queued and is read again by the next call; one answered with an error is dropped, since the
+slot is empty, e.g. already read with mqtt_read().\n
+If notifications have been lost because the queue was full, all the ME310_MQTT_SLOTS slots of the client
+instance are read once; the slots answered with an error are empty.
+ * \param aTimeout timeout in ms of each read
+ * \return RETURN_TOUT if a read timed out, otherwise the return code of the first failed read, RETURN_VALID if none
+ */
+ME310::return_t ME310::mqtt_process_messages(tout_t aTimeout)
+{
+   mqtt_message_t message;
+   return_t rc;
+   return_t ret = RETURN_VALID;
+   while(mMqttRingCount > 0)
+   {
+      rc = mqtt_read_message(mMqttRing[mMqttRingHead].instance, mMqttRing[mMqttRingHead].mId, message, aTimeout);
+      if(rc == RETURN_TOUT)
+      {
+         return rc;
+      }
+      mMqttRingHead = (mMqttRingHead + 1) % ME310_MQTT_RING_SIZE;
+      mMqttRingCount--;
+      if(rc == RETURN_VALID)
+      {
+         on_mqtt_message(message);
+      }
+      else if(ret == RETURN_VALID)
+      {
+         ret = rc;
+      }
+   }
+   for(int instance = 0; mMqttRingOverflow != 0 && instance < ME310_MQTT_INSTANCES; instance++)
+   {
+      if(!(mMqttRingOverflow & (1 << instance)))
+      {
+         continue;
+      }
+      /* the bit is cleared first, so notifications lost while reading trigger another pass */
+      mMqttRingOverflow &= (uint8_t)~(1 << instance);
+      for(int mId = 1; mId <= ME310_MQTT_SLOTS; mId++)
+      {
+         rc = mqtt_read_message(instance, mId, message, aTimeout);
+         if(rc == RETURN_TOUT)
+         {
+            mMqttRingOverflow |= (uint8_t)(1 << instance);
+            return rc;
+         }
+         if(rc == RETURN_VALID)
+         {
+            mqtt_unqueue(instance, mId);
+            on_mqtt_message(message);
+         }
+      }
+   }
+   return ret;
+}
+
+//! \brief Removes the notifications of a slot already read from the queue
+/*!
+ * \param instance    client instance
+ * \param mId    message slot Id
+ */
+void ME310::mqtt_unqueue(int instance, int mId)
+{
+   int kept = 0;
+   for(int i = 0; i < mMqttRingCount; i++)
+   {
+      int from = (mMqttRingHead + i) % ME310_MQTT_RING_SIZE;
+      if(mMqttRing[from].instance != instance || mMqttRing[from].mId != mId)
+      {
+         mMqttRing[(mMqttRingHead + kept) % ME310_MQTT_RING_SIZE] = mMqttRing[from];
+         kept++;
+      }
+   }
+   mMqttRingCount = kept;
+}
+
+//! \brief Callback function on MQTT message read by mqtt_process_messages
+/*! \details
+The default implementation dispatches the message to the router set with mqtt_set_router(), if any.
+ * \param message    message read from the module
+ */
+void ME310::on_mqtt_message(const mqtt_message_t &message)
+{
+   if(mMqttRouter != nullptr)
+   {
+      mMqttRouter->dispatch(message);
+   }
+}
+
 // GNSS ------------------------------------------------------------------------
 
 //! \brief Implements the AT$GPSCFG command and waits for OK answer
@@ -7280,15 +9084,186 @@ ME310::return_t ME310::enable_GTP_WWAN_service(int enable, tout_t aTimeout)
    return send_wait((char*)mBuffer, OK_STRING, aTimeout);
 }
 
-//! \brief Implements the AT$GPSACP command and waits for OK answer
-/*! \details
-This command returns information about the last GPS position.
- * \param aTimeout timeout in ms
- * \return return code
- */
-ME310::return_t ME310::gps_get_acquired_position(tout_t aTimeout)
-{
-   return send_wait(F("AT$GPSACP"), OK_STRING, aTimeout);
+//! \brief Implements the AT$GPSACP command and waits for OK answer
+/*! \details
+This command returns information about the last GPS position.
+ * \param aTimeout timeout in ms
+ * \return return code
+ */
+ME310::return_t ME310::gps_get_acquired_position(tout_t aTimeout)
+{
+   return send_wait(F("AT$GPSACP"), OK_STRING, aTimeout);
+}
+
+//! \brief Implements the AT$GPSACP command and decodes the position
+/*! \details
+The position is decoded also when the module has no fix, in that case fix.valid is false. A valid position
+is kept as last fix, returned by gnss_last_fix() without sending commands.
+ * \param fix    filled with the position
+ * \param aTimeout timeout in ms
+ * \return return code, RETURN_ERROR if the answer has no $GPSACP line
+ */
+ME310::return_t ME310::gps_get_acquired_position(gnss_fix_t &fix, tout_t aTimeout)
+{
+   return_t ret = gps_get_acquired_position(aTimeout);
+   if(ret != RETURN_VALID)
+   {
+      return ret;
+   }
+   for(int i = 0; buffer_cstr(i) != NULL; i++)
+   {
+      if(parse_gps_acquired_position(buffer_cstr(i), fix))
+      {
+         fix.timestamp = millis();
+         if(fix.valid)
+         {
+            mLastFix = fix;
+         }
+         return RETURN_VALID;
+      }
+   }
+   return RETURN_ERROR;
+}
+
+//! \brief Returns a position not older than maxAge
+/*! \details
+The last fix is returned if it is fresh enough, otherwise the position is read with AT$GPSACP.
+ * \param fix    filled with the position
+ * \param maxAge max age in ms of the last fix
+ * \param aTimeout timeout in ms
+ * \return return code, RETURN_ERROR if the module has no valid fix
+ */
+ME310::return_t ME310::gnss_get_fix(gnss_fix_t &fix, uint32_t maxAge, tout_t aTimeout)
+{
+   if(gnss_last_fix(fix, maxAge))
+   {
+      return RETURN_VALID;
+   }
+   return_t ret = gps_get_acquired_position(fix, aTimeout);
+   if(ret == RETURN_VALID && !fix.valid)
+   {
+      return RETURN_ERROR;
+   }
+   return ret;
+}
+
+//! \brief Returns the last valid position read with AT$GPSACP
+/*!
+ * \param fix    filled with the last fix, if fresh enough
+ * \param maxAge max age in ms
+ * \return false if no valid fix has been read or it is older than maxAge
+ */
+bool ME310::gnss_last_fix(gnss_fix_t &fix, uint32_t maxAge)
+{
+   if(!mLastFix.valid || gnss_fix_age() > maxAge)
+   {
+      return false;
+   }
+   fix = mLastFix;
+   return true;
+}
+
+//! \brief Returns the age of the last valid position read with AT$GPSACP
+/*!
+ * \return age in ms, 0xFFFFFFFF if no valid fix has been read
+ */
+uint32_t ME310::gnss_fix_age()
+{
+   if(!mLastFix.valid)
+   {
+      return 0xFFFFFFFF;
+   }
+   return (uint32_t)millis() - mLastFix.timestamp;
+}
+
+//! \brief Parses a $GPSACP answer line
+/*! \details
+The format is $GPSACP: <UTC>,<latitude>,<longitude>,<hdop>,<altitude>,<fix>,<cog>,<spkm>,<spkn>,<date>,<nsat_gps>,<nsat_glonass>
+with latitude as ddmm.mmmmN and longitude as dddmm.mmmmE. Empty fields are decoded as 0.
+ * \param aLine    line received from the module
+ * \param fix      filled with the position, timestamp excluded
+ * \return true if the line is a $GPSACP answer
+ */
+bool ME310::parse_gps_acquired_position(const char *aLine, gnss_fix_t &fix)
+{
+   if(aLine == NULL || strncmp(aLine, "$GPSACP:", 8) != 0)
+   {
+      return false;
+   }
+   const char *fields[12];
+   size_t lens[12];
+   const char *p = aLine + 8;
+   while(*p == ' ')
+   {
+      p++;
+   }
+   int count = 0;
+   while(count < 12)
+   {
+      fields[count] = p;
+      lens[count] = strcspn(p, ",");
+      p += lens[count++];
+      if(*p != ',')
+      {
+         break;
+      }
+      p++;
+   }
+   if(count < 6)
+   {
+      return false;
+   }
+   while(count < 12)
+   {
+      fields[count] = "";
+      lens[count++] = 0;
+   }
+
+   uint32_t timestamp = fix.timestamp;
+   memset(&fix, 0, sizeof(fix));
+   fix.timestamp = timestamp;
+   const char *text = fields[0];
+   if(lens[0] >= 6)
+   {
+      fix.hour = (uint8_t)((text[0] - '0') * 10 + (text[1] - '0'));
+      fix.minute = (uint8_t)((text[2] - '0') * 10 + (text[3] - '0'));
+      fix.second = (uint8_t)((text[4] - '0') * 10 + (text[5] - '0'));
+      fix.millisecond = (uint16_t)NMEAParser::decimal(text + 6, 3);
+   }
+   if(lens[1] > 1)
+   {
+      fix.latitude = NMEAParser::coordinate(fields[1]);
+      if(fields[1][lens[1]-1] == 'S')
+      {
+         fix.latitude = -fix.latitude;
+      }
+   }
+   if(lens[2] > 1)
+   {
+      fix.longitude = NMEAParser::coordinate(fields[2]);
+      if(fields[2][lens[2]-1] == 'W')
+      {
+         fix.longitude = -fix.longitude;
+      }
+   }
+   fix.hdop = (uint16_t)NMEAParser::decimal(fields[3], 2);
+   fix.altitude = NMEAParser::decimal(fields[4], 2);
+   fix.fix = (uint8_t)atoi(fields[5]);
+   fix.valid = (fix.fix >= 2);
+   fix.course = (uint16_t)NMEAParser::decimal(fields[6], 2);
+   fix.speed_kmh = (uint32_t)NMEAParser::decimal(fields[7], 3);
+   fix.speed = (uint32_t)NMEAParser::decimal(fields[8], 3);
+   text = fields[9];
+   if(lens[9] >= 6)
+   {
+      fix.day = (uint8_t)((text[0] - '0') * 10 + (text[1] - '0'));
+      fix.month = (uint8_t)((text[2] - '0') * 10 + (text[3] - '0'));
+      fix.year = (uint16_t)(2000 + (text[4] - '0') * 10 + (text[5] - '0'));
+   }
+   fix.gps_satellites = (uint8_t)atoi(fields[10]);
+   fix.glonass_satellites = (uint8_t)atoi(fields[11]);
+   fix.satellites = fix.gps_satellites + fix.glonass_satellites;
+   return true;
 }
 
 //! \brief Implements the AT$AGNSS command and waits for OK answer
@@ -7670,6 +9645,14 @@ ME310::return_t ME310::wait_for(const char *aAnswer, ME310::tout_t aTimeout)
             pBuffer = mpBuffer;
             mpBuffer += bytesRead;
             mBuffLen += bytesRead;
+            if(process_unsolicited((const char *)pBuffer) && *pBuffer == '$')
+            {
+               /* NMEA sentence of the GNSS stream: not part of the answer */
+               mpBuffer -= bytesRead;
+               mBuffLen -= bytesRead;
+               memset(mpBuffer, 0, bytesRead);
+               continue;
+            }
             return_t rc = on_message((const char *)pBuffer);
             if(rc != RETURN_CONTINUE)
                return rc;
@@ -7869,11 +9852,45 @@ ME310::return_t ME310::receive_data(tout_t aTimeout)
          memset(tmp_str,0,ME310_BUFFSIZE);
       }
    }while(timeout < aTimeout);
+   process_unsolicited_lines(tmp_str);
    _payloadData = (uint8_t *) tmp_str;
    on_timeout();
    return RETURN_VALID;
 }
 
+//! \brief Reads and handles unsolicited result codes
+/*! \details
+Reads the lines sent by the module until the timeout expires. The timeout bounds the whole call, not each
+line, so a steady stream of unsolicited codes (e.g. NMEA sentences) does not hold the caller.
+Each line is handled by the driver unsolicited codes parser and passed to on_message().
+ * \param aTimeout total timeout in ms
+ * \return RETURN_VALID if at least one line was received, RETURN_TOUT otherwise
+ */
+ME310::return_t ME310::poll_unsolicited(tout_t aTimeout)
+{
+   return_t rc = RETURN_TOUT;
+   on_receive();
+   mBuffLen = 0;
+   mpBuffer = mBuffer;
+   memset(mBuffer, 0, ME310_BUFFSIZE);
+   uint32_t start = millis();
+   uint32_t elapsed;
+   int len;
+   while((elapsed = millis() - start) < (uint32_t)aTimeout &&
+         (len = read_raw_line((char*)mBuffer, ME310_BUFFSIZE, (tout_t)(aTimeout - elapsed))) >= 0)
+   {
+      if(len == 0)
+      {
+         continue;
+      }
+      mBuffLen = len + 1;
+      process_unsolicited((const char*)mBuffer);
+      on_message((const char*)mBuffer);
+      rc = RETURN_VALID;
+   }
+   return rc;
+}
+
 //! \brief Waits for the answer to an AT command or timeout
 /*!
  * \param aTimeout answer timeout
@@ -7904,6 +9921,7 @@ ME310::return_t ME310::read_line(const char *aAnswer, ME310::tout_t aTimeout)
          mBuffer[bytesRead-1] = 0;
          mBuffLen = bytesRead;
 
+         process_unsolicited((const char *)mBuffer);
          return_t rc = on_message((const char *)mBuffer);
          if(rc != RETURN_CONTINUE)
          {
@@ -7935,6 +9953,495 @@ ME310::return_t ME310::read_line(const char *aAnswer, ME310::tout_t aTimeout)
 return RETURN_TOUT;
 }
 
+//! \brief Reads a line from serial
+/*!
+ * \param aLine      buffer receiving the line, without line terminator
+ * \param aSize      size of the buffer
+ * \param aTimeout   timeout in ms
+ * \return length of the line, -1 on timeout
+ */
+int ME310::read_raw_line(char *aLine, size_t aSize, ME310::tout_t aTimeout)
+{
+   for(unsigned long timeout = 0; timeout < aTimeout; )
+   {
+      int bytesRead = mSerial.readBytesUntil('\n', aLine, aSize-1);
+      if(bytesRead > 0)
+      {
+         if(aLine[bytesRead-1] == '\r')
+            bytesRead--;
+         aLine[bytesRead] = 0;
+         return bytesRead;
+      }
+      timeout += mSerial.getTimeout();
+   }
+   aLine[0] = 0;
+   return -1;
+}
+
+//! \brief Writes binary data to the ME310 serial
+/*! \details
+Unlike send(), the data is not passed to on_command() and is not printed in debug mode,
+so it does not need to be null terminated.
+ * \param aData    data buffer to be sent
+ * \param aLen     amount of data to be written in bytes
+ */
+void ME310::write_payload(const uint8_t *aData, size_t aLen)
+{
+   if(_debug)
+   {
+      Serial.print(F("<payload "));
+      Serial.print((int)aLen);
+      Serial.println(F(" bytes>"));
+   }
+   mSerial.write(aData, aLen);
+}
+
+//! \brief Lists a directory of the M2M file system
+/*! \details
+The entries of the AT\#M2MLIST answer are compared with the given name and, if an index is set, added to it.
+ * \param path    directory path
+ * \param name    entry name to look for, without path, may be NULL
+ * \param found    receives true if the entry is found
+ * \param size    receives the entry size, -1 for directories or if not found
+ * \param aTimeout timeout in ms waiting for each line
+ * \return return code
+ */
+ME310::return_t ME310::list_m2m_directory(const char *path, const char *name, bool &found, int &size, tout_t aTimeout)
+{
+   found = false;
+   size = -1;
+   char command[ME310_BUFFCOMMANDSIZE + ME310_M2M_NAME_SIZE];
+   snprintf(command, sizeof(command)-1, F("AT#M2MLIST=\"%s\""), path);
+   send(command, F("\r"));
+   on_receive();
+   mBuffLen = 0;
+   mpBuffer = mBuffer;
+   memset(mBuffer, 0, ME310_BUFFSIZE);
+   if(mM2MIndex != nullptr)
+   {
+      mM2MIndex->begin(path);
+   }
+
+   char *line = (char*)mBuffer;
+   int len;
+   do
+   {
+      len = read_raw_line(line, ME310_BUFFSIZE, aTimeout);
+      if(len < 0 || str_equal(line, ERROR_STRING) || strncmp(line, CME_ERROR_STRING, strlen(CME_ERROR_STRING)) == 0)
+      {
+         if(mM2MIndex != nullptr)
+         {
+            mM2MIndex->end();
+            mM2MIndex->drop(path);
+         }
+         if(len < 0)
+         {
+            on_timeout();
+            return RETURN_TOUT;
+         }
+         on_error(line);
+         return RETURN_ERROR;
+      }
+      char *entry;
+      int entrySize;
+      if(parse_m2m_entry(line, entry, entrySize))
+      {
+         if(mM2MIndex != nullptr)
+         {
+            mM2MIndex->add(entry, entrySize);
+         }
+         if(name != NULL && strcmp(entry, name) == 0)
+         {
+            found = true;
+            size = entrySize;
+         }
+      }
+      else if(len > 0 && !str_equal(line, OK_STRING))
+      {
+         process_unsolicited(line);
+      }
+   }while(!str_equal(line, OK_STRING));
+   if(mM2MIndex != nullptr)
+   {
+      mM2MIndex->end();
+   }
+   on_valid(line);
+   return RETURN_VALID;
+}
+
+//! \brief Invalidates the cached data of a file or directory
+/*!
+ * \param file_name    file or directory name, with path
+ * \param directory    true to drop also the index of the directory itself
+ */
+void ME310::invalidate_m2m(const char *file_name, bool directory)
+{
+   mM2MSizeName[0] = 0;
+   if(mM2MIndex != nullptr)
+   {
+      mM2MIndex->invalidate(file_name);
+      if(directory)
+      {
+         mM2MIndex->drop(file_name);
+      }
+   }
+}
+
+//! \brief Parses an entry of the AT\#M2MLIST answer
+/*! \details
+Entries have the form #M2MLIST: <name>,<size> for files and #M2MLIST: <DIR>,<name> or <name>,<DIR> for
+directories, the name can be quoted. The line is modified in place to terminate the name.
+ * \param aLine    line of the answer
+ * \param aName    receives the entry name
+ * \param aSize    receives the file size, -1 for directories
+ * \return false if the line is not a file or directory entry
+ */
+bool ME310::parse_m2m_entry(char *aLine, char *&aName, int &aSize)
+{
+   const char *DIR_STRING = "<DIR>";
+   if(strncmp(aLine, "#M2MLIST:", 9) != 0)
+   {
+      return false;
+   }
+   char *p = aLine + 9;
+   while(*p == ' ')
+   {
+      p++;
+   }
+   bool dir = false;
+   if(strncmp(p, DIR_STRING, strlen(DIR_STRING)) == 0)
+   {
+      dir = true;
+      p += strlen(DIR_STRING);
+      while(*p == ' ' || *p == ',')
+      {
+         p++;
+      }
+   }
+   char *rest;
+   if(*p == '"')
+   {
+      aName = ++p;
+      rest = strchr(p, '"');
+      if(rest == NULL)
+      {
+         return false;
+      }
+      *rest++ = 0;
+   }
+   else
+   {
+      aName = p;
+      rest = strchr(p, ',');
+      if(rest != NULL)
+      {
+         *rest++ = 0;
+      }
+      else
+      {
+         rest = p + strlen(p);
+      }
+   }
+   while(*rest == ' ' || *rest == ',')
+   {
+      rest++;
+   }
+   size_t nameLen = strlen(aName);
+   if(nameLen > 0 && aName[nameLen-1] == '/')
+   {
+      aName[--nameLen] = 0;
+      dir = true;
+   }
+   if(nameLen == 0 || strchr(aName, '/') != NULL || strchr(aName, ':') != NULL)
+   {
+      /* path header or free space line */
+      return false;
+   }
+   if(strncmp(rest, DIR_STRING, strlen(DIR_STRING)) == 0)
+   {
+      dir = true;
+   }
+   else if(!dir && (*rest < '0' || *rest > '9'))
+   {
+      return false;
+   }
+   aSize = dir ? -1 : atoi(rest);
+   return true;
+}
+
+//! \brief Handles an unsolicited result code
+/*! \details
+Recognizes the unsolicited result codes handled by the driver and updates its state.
+It never issues commands, so it is safe to call while waiting for an answer.
+ * \param aMessage    line received from the module
+ * \return true if the line is an unsolicited result code handled by the driver
+ */
+bool ME310::process_unsolicited(const char *aMessage)
+{
+   if(aMessage == NULL)
+   {
+      return false;
+   }
+   if(NMEAParser::is_sentence(aMessage))
+   {
+      if(mNmeaParser != nullptr)
+      {
+         mNmeaParser->feed(aMessage);
+      }
+      return true;
+   }
+   if(strncmp(aMessage, "#MQRING: ", 9) == 0)
+   {
+      /* #MQRING: <instanceNumber>,<mId>,<topic>,<len> */
+      char *next;
+      long instance = strtol(aMessage + 9, &next, 10);
+      if(*next != ',')
+      {
+         return false;
+      }
+      long mId = strtol(next + 1, &next, 10);
+      if(mMqttRingCount < ME310_MQTT_RING_SIZE)
+      {
+         int tail = (mMqttRingHead + mMqttRingCount) % ME310_MQTT_RING_SIZE;
+         mMqttRing[tail].instance = instance;
+         mMqttRing[tail].mId = mId;
+         mMqttRingCount++;
+      }
+      else if(instance >= 0 && instance < ME310_MQTT_INSTANCES)
+      {
+         mMqttRingOverflow |= (uint8_t)(1 << instance);
+      }
+      return true;
+   }
+   registration_domain_t domain;
+   registration_t state;
+   if(parse_registration(aMessage, domain, state))
+   {
+      state.timestamp = millis();
+      mRegistration[domain] = state;
+      return true;
+   }
+   if(strncmp(aMessage, "+CMTI: ", 7) == 0)
+   {
+      /* +CMTI: <mem>,<index> */
+      const char *comma = strrchr(aMessage, ',');
+      if(comma == NULL)
+      {
+         return false;
+      }
+      const char *mem = aMessage + 7;
+      if(*mem == '"')
+      {
+         mem++;
+      }
+      size_t memLen = strlen(mSmsMemory);
+      if(memLen > 0 && (strncmp(mem, mSmsMemory, memLen) != 0 || (mem[memLen] != '"' && mem[memLen] != ',')))
+      {
+         /* AT+CMGR reads another storage */
+         mSmsOtherStorage++;
+         return true;
+      }
+      if(!sms_queue((int)strtol(comma + 1, NULL, 10)))
+      {
+         mSmsRingOverflow = true;
+      }
+      return true;
+   }
+   if(strncmp(aMessage, "+CPMS: \"", 8) == 0)
+   {
+      /* answer to the read command, +CPMS: <memr>,<usedr>,<totalr>,...; not an unsolicited code */
+      const char *end = strchr(aMessage + 8, '"');
+      if(end != NULL && (size_t)(end - aMessage - 8) < sizeof(mSmsMemory))
+      {
+         snprintf(mSmsMemory, sizeof(mSmsMemory), "%.*s", (int)(end - aMessage - 8), aMessage + 8);
+      }
+      return false;
+   }
+   lwm2m_event_t event;
+   if(parse_lwm2m_event(aMessage, event))
+   {
+      lwm2m_queue(event);
+      return true;
+   }
+   return false;
+}
+
+//! \brief Queues a LWM2M event to be processed by LWM2M_process_events
+/*! \details
+When the queue is full, a write or execute event, which the server expects to be acknowledged, takes the
+place of the oldest event that needs no acknowledge; any other event is dropped. Dropped events are counted
+by LWM2M_dropped_events().
+ * \param event    event to be queued
+ * \return false if an event has been dropped
+ */
+bool ME310::lwm2m_queue(const lwm2m_event_t &event)
+{
+   bool ack = (event.op == LWM2M_OP_WRITE || event.op == LWM2M_OP_EXECUTE);
+   if(mLwm2mEventCount >= ME310_LWM2M_EVENT_QUEUE_SIZE)
+   {
+      int victim = -1;
+      for(int i = 0; ack && victim < 0 && i < mLwm2mEventCount; i++)
+      {
+         LWM2M_OPERATION op = mLwm2mEvents[(mLwm2mEventHead + i) % ME310_LWM2M_EVENT_QUEUE_SIZE].op;
+         if(op != LWM2M_OP_WRITE && op != LWM2M_OP_EXECUTE)
+         {
+            victim = i;
+         }
+      }
+      mLwm2mDroppedEvents++;
+      if(victim < 0)
+      {
+         if(ack)
+         {
+            mLwm2mDroppedACKs++;
+         }
+         return false;
+      }
+      for(int i = victim; i < mLwm2mEventCount - 1; i++)
+      {
+         mLwm2mEvents[(mLwm2mEventHead + i) % ME310_LWM2M_EVENT_QUEUE_SIZE] = mLwm2mEvents[(mLwm2mEventHead + i + 1) % ME310_LWM2M_EVENT_QUEUE_SIZE];
+      }
+      mLwm2mEventCount--;
+   }
+   int tail = (mLwm2mEventHead + mLwm2mEventCount) % ME310_LWM2M_EVENT_QUEUE_SIZE;
+   mLwm2mEvents[tail] = event;
+   mLwm2mEventCount++;
+   return true;
+}
+
+//! \brief Parses a LWM2M unsolicited result code
+/*! \details
+Recognized formats are #LWM2MRING: <op>,<uri>[,<value>] and #LWM2MEVT: <event>[,<value>].
+The URI can be reported as /obj/inst/res/resInst path, quoted or not, or as obj,inst,res fields.
+ * \param aMessage    line received from the module
+ * \param event       filled with the parsed event
+ * \return true if the line is a LWM2M unsolicited result code
+ */
+bool ME310::parse_lwm2m_event(const char *aMessage, lwm2m_event_t &event)
+{
+   static const struct
+   {
+      const char *name;
+      LWM2M_OPERATION op;
+   } OPERATIONS[] =
+   {
+      {"READ", LWM2M_OP_READ}, {"WRITE", LWM2M_OP_WRITE}, {"EXECUTE", LWM2M_OP_EXECUTE},
+      {"DISCOVER", LWM2M_OP_DISCOVER}, {"OBSERVE", LWM2M_OP_OBSERVE}, {"CANCEL", LWM2M_OP_CANCEL},
+      {"CREATE", LWM2M_OP_CREATE}, {"DELETE", LWM2M_OP_DELETE}, {"WRITE_ATTR", LWM2M_OP_WRITE_ATTR}
+   };
+   const char *p;
+   bool isEvent;
+   if(strncmp(aMessage, "#LWM2MRING: ", 12) == 0)
+   {
+      p = aMessage + 12;
+      isEvent = false;
+   }
+   else if(strncmp(aMessage, "#LWM2MEVT: ", 11) == 0)
+   {
+      p = aMessage + 11;
+      isEvent = true;
+   }
+   else
+   {
+      return false;
+   }
+
+   memset(&event, 0, sizeof(event));
+   event.objID = event.instanceID = event.resourceID = event.resourceInstance = -1;
+   size_t len = strcspn(p, ",");
+   size_t copy = (len < sizeof(event.name)) ? len : sizeof(event.name) - 1;
+   memcpy(event.name, p, copy);
+   p += len;
+   if(*p == ',')
+   {
+      p++;
+   }
+
+   if(isEvent)
+   {
+      event.op = LWM2M_OP_EVENT;
+   }
+   else
+   {
+      event.op = LWM2M_OP_UNKNOWN;
+      for(size_t i = 0; i < sizeof(OPERATIONS) / sizeof(OPERATIONS[0]); i++)
+      {
+         if(strcmp(event.name, OPERATIONS[i].name) == 0)
+         {
+            event.op = OPERATIONS[i].op;
+            break;
+         }
+      }
+      int *ids[] = {&event.objID, &event.instanceID, &event.resourceID, &event.resourceInstance};
+      bool quoted = (*p == '"');
+      if(quoted)
+      {
+         p++;
+      }
+      char separator = (*p == '/') ? '/' : ',';
+      if(*p == '/')
+      {
+         p++;
+      }
+      for(int i = 0; i < 4 && *p >= '0' && *p <= '9'; i++)
+      {
+         char *end;
+         *ids[i] = strtol(p, &end, 10);
+         p = end;
+         if(*p != separator || (separator == ',' && i == 2))
+         {
+            break;
+         }
+         p++;
+      }
+      if(quoted && *p == '"')
+      {
+         p++;
+      }
+      if(*p == ',')
+      {
+         p++;
+      }
+   }
+   strncpy(event.value, p, sizeof(event.value) - 1);
+   return true;
+}
+
+//! \brief Handles the unsolicited result codes contained in a text
+/*! \details
+The text is split in lines, each line is passed to process_unsolicited(). The text is left unchanged.
+ * \param aText    null terminated text received from the module
+ */
+void ME310::process_unsolicited_lines(char *aText)
+{
+   char *line = aText;
+   while(line != NULL && *line != 0)
+   {
+      char *end = strchr(line, '\n');
+      char *cr = NULL;
+      if(end != NULL)
+      {
+         *end = 0;
+      }
+      if(end != NULL && end > line && end[-1] == '\r')
+      {
+         cr = end - 1;
+         *cr = 0;
+      }
+      process_unsolicited(line);
+      if(cr != NULL)
+      {
+         *cr = '\r';
+      }
+      if(end == NULL)
+      {
+         break;
+      }
+      *end = '\n';
+      line = end + 1;
+   }
+}
+
 //! \brief Returns a string with return_t codes
 /*!
  * \param  rc    return code
@@ -8150,6 +10657,29 @@ void ME310::ConvertBufferToIRA(uint8_t* recv_buf, uint8_t* out_buf, int size)
     out_buf[size*2] = '\0';
 }
 
+//! \brief Computes the CRC-32 of a buffer
+/*! \details
+IEEE 802.3 polynomial, the same of zlib. The value of a previous call can be passed to continue the
+computation over more buffers, 0 starts a new one.
+ * \param crc     CRC-32 of the previous data, 0 for the first buffer
+ * \param data    data buffer
+ * \param len     number of bytes
+ * \return CRC-32 of the data
+ */
+uint32_t ME310::crc32(uint32_t crc, const uint8_t *data, size_t len)
+{
+   crc = ~crc;
+   while(len-- > 0)
+   {
+      crc ^= *data++;
+      for(int bit = 0; bit < 8; bit++)
+      {
+         crc = (crc >> 1) ^ (0xEDB88320UL & (0UL - (crc & 1)));
+      }
+   }
+   return ~crc;
+}
+
 /*! \brief Convert float to string
 /*! \details
 This method converts float value to string
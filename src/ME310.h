@@ -34,10 +34,28 @@
 
 namespace me310
 {
+   class MQTTRouter;
+   class LWM2MDispatcher;
+   class LWM2MObjectTree;
+   class M2MIndex;
+   class NMEAParser;
 
    #define ME310_BUFFSIZE 3100 ///< Exchange buffer size
    #define ME310_SEND_BUFFSIZE 1500
    #define ME310_BUFFCOMMANDSIZE 64
+   #define ME310_HTTP_PROFILES 3            ///< Number of HTTP profiles handled by AT#HTTPCFG
+   #define ME310_HTTP_CFG_CACHE_SIZE 160    ///< Max length of a cached AT#HTTPCFG command
+   #define ME310_MQTT_RING_SIZE 16          ///< Max number of #MQRING notifications waiting for AT#MQREAD
+   #define ME310_MQTT_SLOTS 30              ///< Message slots of a MQTT client instance, read again after a #MQRING overflow
+   #define ME310_MQTT_INSTANCES 8           ///< Client instances tracked by the #MQRING overflow bitmask, bits of mMqttRingOverflow
+   #define ME310_LWM2M_EVENT_QUEUE_SIZE 8   ///< Max number of LWM2M events waiting for LWM2M_process_events
+   #define ME310_LWM2M_EVENT_VALUE_SIZE 40  ///< Max length of the value of a LWM2M event, including terminator
+   #define ME310_M2M_NAME_SIZE 64           ///< Max length of a M2M file system path, including terminator
+   #define ME310_SMS_ADDRESS_SIZE 24        ///< Max length of a SMS address, including terminator
+   #define ME310_SMS_TIMESTAMP_SIZE 24      ///< Max length of a SMS time stamp, including terminator
+   #define ME310_SMS_HEADER_SIZE 128        ///< Max length of a +CMGL header line kept between two records
+   #define ME310_SMS_MAX_INDEX 255          ///< Max message index that can be marked for deletion during a listing
+   #define ME310_SMS_RING_SIZE 8            ///< Max number of +CMTI notifications waiting for sms_process_messages
 
    #define F(A) A
 
@@ -107,6 +125,164 @@ namespace me310
          REGISTRATION_UPDATE = 2,
          REGISTRATION_INFO = 3
       } LWM2M_REG_ACTION;
+
+      typedef enum
+      {
+         LWM2M_OP_UNKNOWN = 0,
+         LWM2M_OP_READ,
+         LWM2M_OP_WRITE,
+         LWM2M_OP_EXECUTE,
+         LWM2M_OP_DISCOVER,
+         LWM2M_OP_OBSERVE,
+         LWM2M_OP_CANCEL,
+         LWM2M_OP_CREATE,
+         LWM2M_OP_DELETE,
+         LWM2M_OP_WRITE_ATTR,
+         LWM2M_OP_EVENT
+      } LWM2M_OPERATION;
+
+      /*! \struct lwm2m_event_t
+         \brief LWM2M event reported by a #LWM2MRING or #LWM2MEVT unsolicited code
+         \details
+         For #LWM2MEVT events the operation is LWM2M_OP_EVENT and the URI fields are -1.
+      */
+      typedef struct
+      {
+         LWM2M_OPERATION op;                       ///< Operation requested by the server
+         char name[16];                            ///< Operation or event name, as reported by the module
+         int objID;                                ///< Object identifier, -1 if not reported
+         int instanceID;                           ///< Object instance identifier, -1 if not reported
+         int resourceID;                           ///< Resource identifier, -1 if not reported
+         int resourceInstance;                     ///< Resource instance identifier, -1 if not reported
+         char value[ME310_LWM2M_EVENT_VALUE_SIZE]; ///< Remaining fields of the unsolicited code, truncated
+      } lwm2m_event_t;
+
+      typedef enum
+      {
+         REGISTRATION_CS = 0,          ///< Circuit switched domain, +CREG
+         REGISTRATION_GPRS,            ///< GPRS domain, +CGREG
+         REGISTRATION_EPS,             ///< EPS domain, +CEREG
+         REGISTRATION_DOMAINS          ///< Number of domains
+      } registration_domain_t;
+
+      /*! \struct registration_t
+         \brief Network registration state of a domain, from +CREG, +CGREG and +CEREG
+      */
+      typedef struct
+      {
+         int stat;                     ///< 0 not registered, 1 home, 2 searching, 3 denied, 4 unknown, 5 roaming, -1 not reported yet
+         uint32_t area;                ///< Location area code or tracking area code, 0 if not reported
+         uint32_t cell;                ///< Cell identifier, 0 if not reported
+         int act;                      ///< Access technology, e.g. 0 GSM, 8 CAT-M1, 9 NB-IoT, -1 if not reported
+         uint32_t timestamp;           ///< millis() of the last update
+      } registration_t;
+
+      /*! \struct http_profile_t
+         \brief HTTP profile parameters, as set with AT\#HTTPCFG
+      */
+      typedef struct
+      {
+         int prof_id;                  ///< Profile identifier (0-2)
+         const char *server_address;   ///< IP address or host name of the HTTP server
+         int server_port;              ///< TCP remote port
+         int auth_type;                ///< HTTP authentication type
+         const char *username;         ///< Authentication user identification string
+         const char *password;         ///< Authentication password string
+         int ssl_enabled;              ///< SSL encryption enable
+         int timeout;                  ///< Timeout for data from the server, in seconds
+         int cid;                      ///< PDP context identifier
+         int pkt_size;                 ///< Packet size for #HTTPSND/#HTTPRCV
+      } http_profile_t;
+
+      /*! \struct mqtt_message_t
+         \brief MQTT message read from a module slot
+         \details
+         Topic and payload point into the class memory buffer and are valid until the next command.
+      */
+      typedef struct
+      {
+         int instance;                 ///< MQTT client instance
+         int mId;                      ///< Message slot identifier
+         const char *topic;            ///< Topic the message was published to
+         const uint8_t *payload;       ///< Message payload, not null terminated for binary data
+         int len;                      ///< Payload length in bytes
+      } mqtt_message_t;
+
+      /*! \struct mqtt_publish_stats_t
+         \brief Statistics of the MQTT messages published with mqtt_publish_binary
+         \details
+         A publish is acknowledged when the module answers OK to AT#MQPUBSEXT. For QoS 1 and 2 the latency
+         is measured from the command to the acknowledgement.
+      */
+      typedef struct
+      {
+         uint32_t published;           ///< Number of acknowledged publishes
+         uint32_t failed;              ///< Number of publishes answered with error or timeout
+         uint32_t bytes;               ///< Payload bytes of the acknowledged publishes
+         uint32_t qos_acknowledged;    ///< Number of acknowledged publishes with QoS 1 or 2
+         uint32_t last_latency;        ///< Latency of the last acknowledged QoS 1 or 2 publish, in ms
+         uint32_t max_latency;         ///< Max latency of the acknowledged QoS 1 or 2 publishes, in ms
+         uint32_t total_latency;       ///< Sum of the latencies of the acknowledged QoS 1 or 2 publishes, in ms
+      } mqtt_publish_stats_t;
+
+      typedef bool (*m2m_sink_t)(const uint8_t *data, size_t len, void *context);   //!< Receives the chunks of a M2M file, returns false to stop the delivery
+      typedef size_t (*m2m_source_t)(uint8_t *data, size_t len, void *context);  //!< Fills up to len bytes of a M2M file, returns the number of bytes filled
+
+      /*! \struct m2m_transfer_t
+         \brief Report of a M2M file transfer
+      */
+      typedef struct
+      {
+         uint32_t len;                 ///< Number of bytes given by the source
+         uint32_t checksum;            ///< CRC-32 of the bytes given by the source
+      } m2m_transfer_t;
+
+      /*! \struct sms_message_t
+         \brief SMS read from the message storage
+         \details
+         The text points into the class memory buffer and is valid until the next command.
+      */
+      typedef struct
+      {
+         int index;                                ///< Message index in the storage, -1 if not reported
+         int stat;                                 ///< 0 received unread, 1 received read, 2 stored unsent, 3 stored sent
+         char sender[ME310_SMS_ADDRESS_SIZE];      ///< Originator or destination address, empty in PDU mode
+         char timestamp[ME310_SMS_TIMESTAMP_SIZE]; ///< Service centre time stamp, empty if not reported
+         const char *text;                         ///< Message text, or the PDU in hex in PDU mode, not null terminated
+         int len;                                  ///< Length of the text
+         int size;                                 ///< <length> of the header: characters or octets of the text, TPDU octets in PDU mode; -1 if not reported
+      } sms_message_t;
+
+      typedef bool (*sms_handler_t)(const sms_message_t &message, void *context);   //!< Receives a SMS, returns true to delete it
+
+      /*! \struct gnss_fix_t
+         \brief Position reported by AT$GPSACP
+         \details
+         Fields not reported by the module are 0. Coordinates use the same fixed point units as NMEAParser::fix_t.
+      */
+      typedef struct
+      {
+         bool valid;                   ///< 2D or 3D fix
+         uint8_t fix;                  ///< Fix type, 0 or 1 invalid, 2 2D, 3 3D
+         uint8_t hour;                 ///< UTC hour
+         uint8_t minute;               ///< UTC minute
+         uint8_t second;               ///< UTC second
+         uint16_t millisecond;         ///< UTC millisecond
+         uint8_t day;                  ///< UTC day
+         uint8_t month;                ///< UTC month
+         uint16_t year;                ///< UTC year
+         int32_t latitude;             ///< Latitude, in 1e-7 degrees, north positive
+         int32_t longitude;            ///< Longitude, in 1e-7 degrees, east positive
+         int32_t altitude;             ///< Altitude above mean sea level, in cm
+         uint16_t hdop;                ///< Horizontal dilution of precision, in 1/100
+         uint16_t course;              ///< Course over ground, in 1/100 degree
+         uint32_t speed;               ///< Speed over ground, in 1/1000 knot
+         uint32_t speed_kmh;           ///< Speed over ground, in 1/1000 km/h
+         uint8_t satellites;           ///< Satellites used, GPS and GLONASS
+         uint8_t gps_satellites;       ///< GPS satellites used
+         uint8_t glonass_satellites;   ///< GLONASS satellites used
+         uint32_t timestamp;           ///< millis() when the position was read
+      } gnss_fix_t;
       
       #ifdef ARDUINO_TELIT_SAMD_CHARLIE
       ME310(Uart &aSerial = SerialModule);
@@ -435,6 +611,13 @@ namespace me310
       return_t eps_network_registration_status(int mode , tout_t aTimeout = TOUT_100MS);
       _READ_TEST(eps_network_registration_status,"AT+CEREG",TOUT_100MS)
 
+      return_t registration_enable_indications(tout_t aTimeout = TOUT_100MS);
+      return_t wait_until_registered(uint32_t aTimeout, tout_t aLineTimeout = TOUT_100MS);
+      const registration_t &registration(registration_domain_t domain) const { return mRegistration[domain < REGISTRATION_DOMAINS ? domain : REGISTRATION_CS]; }   //!< Returns the last registration state of a domain
+      bool registered(registration_domain_t domain) const { return registration(domain).stat == 1 || registration(domain).stat == 5; }   //!< Returns true if the domain is registered, home or roaming
+      bool registered() const { return registered(REGISTRATION_GPRS) || registered(REGISTRATION_EPS); }   //!< Returns true if the packet domain is registered
+      static bool parse_registration(const char *aLine, registration_domain_t &domain, registration_t &state);
+
       return_t read_current_network_status(tout_t aTimeout = TOUT_100MS);
       _TEST(read_current_network_status,"AT#RFSTS",TOUT_100MS)
 
@@ -571,6 +754,7 @@ namespace me310
       _TEST(list_messages,"AT+CMGL",TOUT_100MS)
 
       return_t read_message(int index, tout_t aTimeout = TOUT_100MS);
+      return_t read_message(int index, sms_message_t &message, tout_t aTimeout = TOUT_1SEC);
       _TEST(read_message,"AT+CMGR",TOUT_100MS)
 
       return_t send_short_message(int length, char* data, tout_t aTimeout = TOUT_100MS);
@@ -587,6 +771,19 @@ namespace me310
       return_t delete_message(int index, int delflag = 0,tout_t aTimeout = TOUT_100MS);
       _TEST(delete_message,"AT+CMGD",TOUT_100MS)
 
+      return_t sms_list_begin(const char *stat = "ALL", tout_t aTimeout = TOUT_1SEC);
+      return_t sms_list_next(sms_message_t &message, tout_t aTimeout = TOUT_1SEC);
+      bool sms_list_delete(int index);
+      return_t sms_list_end(tout_t aTimeout = TOUT_1SEC);
+      return_t sms_drain(const char *stat, sms_handler_t handler, void *context = NULL, tout_t aTimeout = TOUT_1SEC);
+      static bool parse_sms_header(const char *aLine, sms_message_t &message);
+
+      return_t sms_enable_indications(tout_t aTimeout = TOUT_100MS);
+      return_t sms_process_messages(tout_t aTimeout = TOUT_1SEC);
+      int sms_pending_messages() { return mSmsRingCount; }   //!< Returns the number of +CMTI notified messages not yet read
+      uint32_t sms_other_storage_messages() const { return mSmsOtherStorage; }   //!< Returns the +CMTI notified messages not queued because stored outside the storage read by AT+CMGR
+      void sms_set_handler(sms_handler_t handler, void *context = NULL) { mSmsHandler = handler; mSmsHandlerContext = context; }   //!< Sets the handler of the messages read by sms_process_messages
+
       return_t select_service_mo_sms(int service = 1,tout_t aTimeout = TOUT_100MS);
       _READ_TEST(select_service_mo_sms,"AT+CGSMS",TOUT_100MS)
 
@@ -1028,12 +1225,17 @@ namespace me310
       return_t configure_http_parameters(int prof_id, const char *server_address, int server_port, int auth_type, int ssl_enabled = 0, int timeout=120, int cid=1,tout_t aTimeout = TOUT_100MS);
       _READ_TEST(configure_http_parameters,"AT#HTTPCFG",TOUT_100MS)
 
+      return_t configure_http_profile(const http_profile_t &profile, tout_t aTimeout = TOUT_100MS);
+      void invalidate_http_profile(int prof_id = -1);
+
       return_t send_http_query(int prof_id, int command, const char *resource, const char *extra_header_line,tout_t aTimeout = TOUT_100MS);
       return_t send_http_query(int prof_id, int command, const char *resource, tout_t aTimeout = TOUT_100MS);
+      return_t send_http_query(const http_profile_t &profile, int command, const char *resource, const char *extra_header_line = "", tout_t aTimeout = TOUT_100MS);
       _TEST(send_http_query,"AT#HTTPQRY",TOUT_100MS)
 
       return_t send_http_send(int prof_id, int command, const char *resource, int data_len, char *data, const char *post_param ="", const char *extra_header_line = "", tout_t aTimeout = TOUT_100MS);
       return_t send_http_send_without_params(int prof_id, int command, const char *resource, int data_len, char *data, tout_t aTimeout = TOUT_100MS);
+      return_t send_http_send(const http_profile_t &profile, int command, const char *resource, int data_len, char *data, const char *post_param ="", const char *extra_header_line = "", tout_t aTimeout = TOUT_100MS);
       _TEST(send_http_send,"AT#HTTPSND",TOUT_100MS)
 
       void receive_http_data_start(int prof_id, int max_byte = 0);
@@ -1148,8 +1350,14 @@ namespace me310
       return_t LWM2M_read_resource_string(int agent, int objID, int instanceID, int resourceID, int resourceInstance, tout_t aTimeout=TOUT_100MS);
       _READ_TEST(LWM2M_read_resource_string,"AT#LWM2MR",TOUT_100MS)
 
+      return_t LWM2M_read_resource_float(int agent, int objID, int instanceID, int resourceID, int resourceInstance, float &value, tout_t aTimeout=TOUT_100MS);
+      return_t LWM2M_read_resource_string(int agent, int objID, int instanceID, int resourceID, int resourceInstance, char *value, size_t size, tout_t aTimeout=TOUT_100MS);
+      return_t LWM2M_read_resource_opaque(int agent, int objID, int instanceID, int resourceID, int resourceInstance, uint8_t *value, size_t size, size_t &len, tout_t aTimeout=TOUT_100MS);
+      return_t LWM2M_read_resource_time(int agent, int objID, int instanceID, int resourceID, int resourceInstance, uint32_t &value, tout_t aTimeout=TOUT_100MS);
+
       return_t LWM2M_set_object(int agent, int objID, int instanceID, char* jsonString, tout_t aTimeout=TOUT_100MS);
       _READ_TEST(LWM2M_set_object,"AT#LWM2MOBJSET",TOUT_100MS)
+      return_t LWM2M_set_object_json(int agent, int objID, int instanceID, const char *json, size_t len, tout_t aTimeout=TOUT_1SEC);
 
       return_t LWM2M_check_agent_exist(int agentInstance, tout_t aTimeout=TOUT_100MS);
       _READ_TEST(LWM2M_check_agent_exist,"AT#LWM2MEXIST",TOUT_100MS)
@@ -1166,6 +1374,13 @@ namespace me310
       return_t LWM2M_send_ACK(tout_t aTimeout=TOUT_100MS);
       _TEST(LWM2M_send_ACK,"AT#LWM2MACK",TOUT_100MS)
 
+      return_t LWM2M_process_events(tout_t aTimeout = TOUT_100MS);
+      int LWM2M_pending_events() { return mLwm2mEventCount; }   //!< Returns the number of LWM2M events not yet processed
+      uint32_t LWM2M_dropped_events() const { return mLwm2mDroppedEvents; }   //!< Returns the number of LWM2M events dropped because the queue was full
+      uint32_t LWM2M_dropped_ACKs() const { return mLwm2mDroppedACKs; }   //!< Returns the number of dropped write and execute events, left without acknowledge
+      void LWM2M_set_dispatcher(LWM2MDispatcher *dispatcher) { mLwm2mDispatcher = dispatcher; }   //!< Sets the dispatcher of the events processed by LWM2M_process_events
+      void LWM2M_set_auto_ACK(bool enable) { mLwm2mAutoAck = enable; }   //!< Sends AT#LWM2MACK after each processed write or execute event
+
       return_t LWM2M_set_configuration(int agentID, int paramID, int value, tout_t aTimeout = TOUT_100MS);
       _READ_TEST(LWM2M_set_configuration,"AT#LWM2MCFG",TOUT_100MS)
 
@@ -1204,6 +1419,7 @@ namespace me310
 
       return_t LWM2M_get_object_resource(int agentInstanceID, int objectID, int objectInstanceID, int resourceID, tout_t aTimeout = TOUT_100MS);
       _READ_TEST(LWM2M_get_object_resource,"AT#LWM2MOBJGET",TOUT_100MS)
+      return_t LWM2M_get_object_tree(int agentInstanceID, int objectID, LWM2MObjectTree &tree, int objectInstanceID = -1, int resourceID = -1, tout_t aTimeout = TOUT_1SEC);
 
       return_t LWM2M_client_current_status(tout_t aTimeout = TOUT_100MS);
       _TEST(LWM2M_client_current_status,"AT#LWM2MSTAT",TOUT_100MS)
@@ -1246,6 +1462,7 @@ namespace me310
       _TEST(m2m_delete,"AT#M2MDEL",TOUT_100MS)
 
       return_t m2m_write_file(const char *file_name, int size, int binToMod, char* data, tout_t aTimeout = TOUT_100MS);
+      return_t m2m_write_file(const char *file_name, int size, int binToMod, m2m_source_t source, void *context, m2m_transfer_t *report = NULL, tout_t aTimeout = TOUT_1SEC);
       _TEST(m2m_write_file,"AT#M2MWRITE",TOUT_100MS)
 
       return_t m2m_list(const char *path,tout_t aTimeout = TOUT_100MS);
@@ -1254,6 +1471,11 @@ namespace me310
 
       return_t m2m_read(const char *file_name,tout_t aTimeout = TOUT_100MS);
       _TEST(m2m_read,"AT#M2MREAD",TOUT_100MS)
+      return_t m2m_read_file(const char *file_name, m2m_sink_t sink, void *context = NULL, int size = -1, tout_t aTimeout = TOUT_1SEC);
+      return_t m2m_file_size(const char *file_name, int &size, tout_t aTimeout = TOUT_1SEC);
+      return_t m2m_file_exists(const char *file_name, tout_t aTimeout = TOUT_1SEC);
+      return_t m2m_index_directory(const char *path, tout_t aTimeout = TOUT_1SEC);
+      void m2m_set_index(M2MIndex *index) { mM2MIndex = index; }   //!< Sets the index used by m2m_file_size and m2m_file_exists
 
       return_t m2m_ram_info(tout_t aTimeout = TOUT_100MS);
       _TEST(m2m_ram_info,"AT#M2MRAM",TOUT_100MS)
@@ -1293,9 +1515,20 @@ namespace me310
       return_t mqtt_publish(int instanceNumber, const char *topic, int retain, int qos, const char *message, tout_t aTimeout = TOUT_100MS);
       _TEST(mqtt_publish,"AT#MQPUBS",TOUT_100MS)
 
+      return_t mqtt_publish_binary(int instanceNumber, const char *topic, int retain, int qos, const uint8_t *payload, int len, tout_t aTimeout = TOUT_1SEC);
+      _TEST(mqtt_publish_binary,"AT#MQPUBSEXT",TOUT_100MS)
+      const mqtt_publish_stats_t &mqtt_publish_statistics() const { return mMqttPublishStats; }   //!< Returns the statistics of mqtt_publish_binary
+      void mqtt_reset_publish_statistics() { memset(&mMqttPublishStats, 0, sizeof(mMqttPublishStats)); }   //!< Resets the statistics of mqtt_publish_binary
+
       return_t mqtt_read(int instanceNumber, int mId, tout_t aTimeout = TOUT_100MS);
       _READ_TEST(mqtt_read,"AT#MQREAD",TOUT_100MS)
 
+      return_t mqtt_read_message(int instanceNumber, int mId, mqtt_message_t &message, tout_t aTimeout = TOUT_1SEC);
+      return_t mqtt_process_messages(tout_t aTimeout = TOUT_1SEC);
+      int mqtt_pending_messages() { return mMqttRingCount; }   //!< Returns the number of #MQRING notified messages not yet read
+      bool mqtt_ring_overflow() const { return mMqttRingOverflow != 0; }   //!< Returns true if #MQRING notifications have been lost and the slots are still to be read again
+      void mqtt_set_router(MQTTRouter *router) { mMqttRouter = router; }   //!< Sets the router of the messages read by mqtt_process_messages
+
    // GNSS ------------------------------------------------------------------------
 
       return_t gnss_configuration(int parameter, int value, tout_t aTimeout = TOUT_100MS);
@@ -1330,10 +1563,17 @@ namespace me310
 
       return_t gps_get_acquired_position(tout_t aTimeout = TOUT_100MS);
       _READ_TEST(gps_get_acquired_position, "AT$GPSACP", TOUT_100MS)
+      return_t gps_get_acquired_position(gnss_fix_t &fix, tout_t aTimeout = TOUT_100MS);
+      return_t gnss_get_fix(gnss_fix_t &fix, uint32_t maxAge, tout_t aTimeout = TOUT_100MS);
+      bool gnss_last_fix(gnss_fix_t &fix, uint32_t maxAge = 0xFFFFFFFF);
+      uint32_t gnss_fix_age();
+      static bool parse_gps_acquired_position(const char *aLine, gnss_fix_t &fix);
 
       return_t gnss_set_agnss_enable(int provider, int status, tout_t aTimeout = TOUT_100MS);
       _READ_TEST(gnss_set_agnss_enable, "AT$AGNSS", TOUT_100MS)
 
+      void gnss_set_nmea_parser(NMEAParser *parser) { mNmeaParser = parser; }   //!< Sets the parser of the NMEA sentences received as unsolicited lines
+
    // Mobile Broadband ------------------------------------------------------------
 
       return_t ecm_setup(int cid, int did = 0, tout_t aTimeout = TOUT_100MS);
@@ -1367,6 +1607,7 @@ namespace me310
       return_t send_command(const char *aCommand, const char *aAnswer = OK_STRING, tout_t aTimeout = TOUT_200MS);
       void send_data(const char *aCommand, const char* term = TERMINATION_STRING, tout_t aTimeout = TOUT_200MS);
       virtual return_t receive_data(tout_t aTimeout = TOUT_200MS);
+      return_t poll_unsolicited(tout_t aTimeout = TOUT_100MS);
 
    // Deprecated methods-----------------------------------------------------------
       [[deprecated("Use LWM2M_enable(int enable, int ctxID, tout_t aTimeout) instead.")]]
@@ -1482,6 +1723,9 @@ namespace me310
       {return RETURN_CONTINUE;}
       virtual const char* on_pending_receive(const char *aMessage) //!< Callback function on string received
       {return aMessage;}
+      virtual void on_mqtt_message(const mqtt_message_t &message);      //!< Callback function on MQTT message read by mqtt_process_messages
+      virtual void on_lwm2m_event(const lwm2m_event_t &event);           //!< Callback function on LWM2M event processed by LWM2M_process_events
+      virtual bool on_sms_message(const sms_message_t &message);         //!< Callback function on SMS read by sms_process_messages, returns true to delete it
 
       return_t read_line(const char *aAnswer, tout_t aTimeout = TOUT_1SEC);
       virtual return_t wait_for(const char *aAnswer = OK_STRING, tout_t aTimeout = TOUT_200MS);
@@ -1491,6 +1735,8 @@ namespace me310
       static const char *str_start(const char *buffer, const char *string);
       static const char *str_equal(const char *buffer, const char *string);
       static const char *return_string(return_t rc);
+      static uint32_t crc32(uint32_t crc, const uint8_t *data, size_t len);
+      static char * floatToString(double number, int digits, char *buf, int size);
 
       Uart* getSerial(){return &mSerial;}
 
@@ -1506,8 +1752,25 @@ namespace me310
       return_t send_wait(const char *aCommand, int flag, const char *aAnswer = OK_STRING, const char* term = TERMINATION_STRING, tout_t aTimeout = TOUT_200MS);
 
       void CheckIRAOption(char* str);
+      return_t send_wait_http_cfg(int prof_id, tout_t aTimeout);
+      const char *read_lwm2m_value(int agent, int objID, int instanceID, int resourceID, int resourceInstance, return_t &ret, tout_t aTimeout);
+
+      bool process_unsolicited(const char *aMessage);
+      bool parse_lwm2m_event(const char *aMessage, lwm2m_event_t &event);
+      void process_unsolicited_lines(char *aText);
+      int read_raw_line(char *aLine, size_t aSize, tout_t aTimeout);
+      void write_payload(const uint8_t *aData, size_t aLen);
+      static bool parse_m2m_entry(char *aLine, char *&aName, int &aSize);
+      bool read_sms_text(sms_message_t &message, tout_t aTimeout);
+      bool sms_queue(int index);
+      void mqtt_unqueue(int instance, int mId);
+      bool lwm2m_queue(const lwm2m_event_t &event);
+      return_t sms_process_message(int index, tout_t aTimeout);
+      static bool sms_list_boundary(const char *aLine);
+      static size_t copy_source(uint8_t *data, size_t len, void *context);
+      return_t list_m2m_directory(const char *path, const char *name, bool &found, int &size, tout_t aTimeout);
+      void invalidate_m2m(const char *file_name, bool directory = false);
 
-      char * floatToString(double number, int digits, char *buf, int size);
 
 
       Uart &mSerial;                    //!< Reference to Uart used for communication
@@ -1521,6 +1784,56 @@ namespace me310
       bool _isIRARx, _isIRATx;
       bool _debug;
 
+      char mHttpCfgCache[ME310_HTTP_PROFILES][ME310_HTTP_CFG_CACHE_SIZE] = {}; //!< Last AT#HTTPCFG accepted for each profile
+
+      struct
+      {
+         uint8_t instance;              //!< MQTT client instance
+         uint8_t mId;                   //!< Message slot identifier
+      } mMqttRing[ME310_MQTT_RING_SIZE]; //!< Queue of #MQRING notified slots
+      int mMqttRingHead = 0;            //!< Index of the oldest queued slot
+      int mMqttRingCount = 0;           //!< Number of queued slots
+      uint8_t mMqttRingOverflow = 0;    //!< Bitmask of the client instances whose #MQRING notifications have been lost, ME310_MQTT_INSTANCES bits
+      static_assert(ME310_MQTT_INSTANCES <= 8 * sizeof(uint8_t), "mMqttRingOverflow must have a bit per MQTT instance");
+      MQTTRouter *mMqttRouter = nullptr; //!< Router of the messages read by mqtt_process_messages
+      mqtt_publish_stats_t mMqttPublishStats = {}; //!< Statistics of mqtt_publish_binary
+
+      lwm2m_event_t mLwm2mEvents[ME310_LWM2M_EVENT_QUEUE_SIZE]; //!< Queue of LWM2M events
+      int mLwm2mEventHead = 0;          //!< Index of the oldest queued event
+      int mLwm2mEventCount = 0;         //!< Number of queued events
+      LWM2MDispatcher *mLwm2mDispatcher = nullptr; //!< Dispatcher of the events processed by LWM2M_process_events
+      bool mLwm2mAutoAck = false;       //!< Sends AT#LWM2MACK after each processed write or execute event
+      uint32_t mLwm2mDroppedEvents = 0; //!< LWM2M events dropped because the queue was full
+      uint32_t mLwm2mDroppedACKs = 0;   //!< Dropped write and execute events, never acknowledged
+
+      char mM2MSizeName[ME310_M2M_NAME_SIZE] = {}; //!< File whose size is cached by m2m_file_size
+      int mM2MSize = -1;                //!< Cached size of mM2MSizeName
+      M2MIndex *mM2MIndex = nullptr;    //!< Directory index, replaces the single size cache when set
+      NMEAParser *mNmeaParser = nullptr; //!< Parser of the NMEA unsolicited sentences
+      gnss_fix_t mLastFix = {};         //!< Last valid position read with AT$GPSACP
+
+      bool mSmsListing = false;         //!< AT+CMGL listing in progress
+      bool mSmsListAll = false;         //!< The listing includes all the messages
+      bool mSmsOnlyReceived = true;     //!< The listed messages are all received messages
+      bool mSmsListComplete = false;    //!< The listing has been ended by OK
+      bool mSmsListSized = true;        //!< All the listed records reported the <length> of their text
+      char mSmsHeader[ME310_SMS_HEADER_SIZE] = {}; //!< Line read after the last record, not handled yet
+      int mSmsListed = 0;               //!< Messages listed
+      int mSmsMarked = 0;               //!< Messages marked for deletion
+      uint8_t mSmsDelete[(ME310_SMS_MAX_INDEX + 8) / 8] = {}; //!< Bitmap of the messages marked for deletion
+
+      int16_t mSmsRing[ME310_SMS_RING_SIZE] = {}; //!< Queue of +CMTI notified message indexes
+      int mSmsRingHead = 0;             //!< Index of the oldest queued message
+      int mSmsRingCount = 0;            //!< Number of queued messages
+      bool mSmsRingOverflow = false;    //!< Notifications have been lost since the last sms_process_messages
+      uint8_t mSmsUnread[(ME310_SMS_MAX_INDEX + 8) / 8] = {}; //!< Bitmap of the listed unread messages not processed yet
+      char mSmsMemory[3] = {};          //!< Storage read by AT+CMGR, from AT+CPMS, empty if not known
+      uint32_t mSmsOtherStorage = 0;    //!< +CMTI notifications of messages stored outside mSmsMemory
+      sms_handler_t mSmsHandler = NULL; //!< Handler of the messages read by sms_process_messages
+      void *mSmsHandlerContext = NULL;  //!< Context passed to the SMS handler
+
+      registration_t mRegistration[REGISTRATION_DOMAINS] = {{-1, 0, 0, -1, 0}, {-1, 0, 0, -1, 0}, {-1, 0, 0, -1, 0}}; //!< Registration state of each domain
+
       static const char CTRZ[1];
 
       static const char *OK_STRING;
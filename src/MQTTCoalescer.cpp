@@ -0,0 +1,275 @@
+/*Copyright (C) 2026 Telit Communications S.p.A. Italy - All Rights Reserved.*/
+/*    See LICENSE file in the project root for full license information.     */
+
+/**
+  @file
+    MQTTCoalescer.cpp
+
+  @brief
+    Coalescing publisher for MQTT telemetry
+
+  @details
+    The class appends the samples published on a topic into a per-topic buffer and publishes
+    the whole buffer with a single command.\n
+
+  @version
+    2.13.1
+
+  @note
+    Dependencies:
+    MQTTCoalescer.h
+
+  @author
+
+  @date
+    18/10/2026
+*/
+
+#include "MQTTCoalescer.h"
+#include <string.h>
+
+using namespace me310;
+
+//! \brief Class Constructor
+/*!
+ * \param module            module used to publish
+ * \param instanceNumber    MQTT client instance
+ * \param qos               QoS of the publishes
+ * \param retain            retain flag of the publishes
+ */
+MQTTCoalescer::MQTTCoalescer(ME310 &module, int instanceNumber, int qos, int retain) :
+   _module(module), _instance(instanceNumber), _qos(qos), _retain(retain),
+   _flushSize(MQTT_COALESCER_BUFFSIZE), _maxAge(0), _separator(-1)
+{
+   clear();
+   reset_statistics();
+}
+
+//! \brief Sets the buffer size that triggers a publish
+/*!
+ * \param size    size in bytes, limited to MQTT_COALESCER_BUFFSIZE
+ */
+void MQTTCoalescer::set_flush_size(size_t size)
+{
+   if(size == 0 || size > MQTT_COALESCER_BUFFSIZE)
+   {
+      size = MQTT_COALESCER_BUFFSIZE;
+   }
+   _flushSize = size;
+}
+
+//! \brief Appends a sample to the buffer of a topic
+/*! \details
+If the sample does not fit in the flush size, the buffer is published first.
+ * \param topic    topic of the sample
+ * \param data     sample data
+ * \param len      sample length in bytes
+ * \return return code of the publish, if any. RETURN_ERROR if the sample has been dropped
+ */
+ME310::return_t MQTTCoalescer::add(const char *topic, const uint8_t *data, size_t len)
+{
+   ME310::return_t ret = ME310::RETURN_VALID;
+   slot_t *slot = find(topic, true);
+   if(slot == NULL || data == NULL)
+   {
+      _stats.dropped++;
+      return ME310::RETURN_ERROR;
+   }
+   size_t needed = len + ((slot->len > 0 && _separator >= 0) ? 1 : 0);
+   if(slot->len > 0 && slot->len + needed > _flushSize)
+   {
+      ret = flush(*slot);
+      needed = len + ((slot->len > 0 && _separator >= 0) ? 1 : 0);
+   }
+   if(slot->len + needed > MQTT_COALESCER_BUFFSIZE)
+   {
+      _stats.dropped++;
+      return ME310::RETURN_ERROR;
+   }
+   if(slot->samples == 0)
+   {
+      slot->first = millis();
+   }
+   if(slot->len > 0 && _separator >= 0)
+   {
+      slot->data[slot->len++] = (uint8_t)_separator;
+   }
+   memcpy(slot->data + slot->len, data, len);
+   slot->len += len;
+   slot->samples++;
+   if(slot->len >= _flushSize)
+   {
+      ret = flush(*slot);
+   }
+   return ret;
+}
+
+//! \brief Appends a text sample to the buffer of a topic
+/*!
+ * \param topic    topic of the sample
+ * \param data     null terminated sample
+ * \return return code, see add(const char*, const uint8_t*, size_t)
+ */
+ME310::return_t MQTTCoalescer::add(const char *topic, const char *data)
+{
+   if(data == NULL)
+   {
+      _stats.dropped++;
+      return ME310::RETURN_ERROR;
+   }
+   return add(topic, (const uint8_t*)data, strlen(data));
+}
+
+//! \brief Publishes the buffers whose oldest sample exceeded the max age
+/*!
+ * \return return code of the first failed publish, RETURN_VALID otherwise
+ */
+ME310::return_t MQTTCoalescer::poll()
+{
+   ME310::return_t ret = ME310::RETURN_VALID;
+   if(_maxAge == 0)
+   {
+      return ret;
+   }
+   uint32_t now = millis();
+   for(int i = 0; i < MQTT_COALESCER_TOPICS; i++)
+   {
+      if(_slots[i].samples > 0 && (uint32_t)(now - _slots[i].first) >= _maxAge)
+      {
+         ME310::return_t rc = flush(_slots[i]);
+         if(rc != ME310::RETURN_VALID && ret == ME310::RETURN_VALID)
+         {
+            ret = rc;
+         }
+      }
+   }
+   return ret;
+}
+
+//! \brief Publishes all the buffers
+/*!
+ * \return return code of the first failed publish, RETURN_VALID otherwise
+ */
+ME310::return_t MQTTCoalescer::flush()
+{
+   ME310::return_t ret = ME310::RETURN_VALID;
+   for(int i = 0; i < MQTT_COALESCER_TOPICS; i++)
+   {
+      if(_slots[i].samples > 0)
+      {
+         ME310::return_t rc = flush(_slots[i]);
+         if(rc != ME310::RETURN_VALID && ret == ME310::RETURN_VALID)
+         {
+            ret = rc;
+         }
+      }
+   }
+   return ret;
+}
+
+//! \brief Publishes the buffer of a topic
+/*!
+ * \param topic    topic to publish
+ * \return return code
+ */
+ME310::return_t MQTTCoalescer::flush(const char *topic)
+{
+   slot_t *slot = find(topic, false);
+   if(slot == NULL || slot->samples == 0)
+   {
+      return ME310::RETURN_VALID;
+   }
+   return flush(*slot);
+}
+
+//! \brief Discards all the buffered samples
+/*!
+ */
+void MQTTCoalescer::clear()
+{
+   memset(_slots, 0, sizeof(_slots));
+}
+
+//! \brief Returns the number of bytes buffered for a topic
+/*!
+ * \param topic    topic of the samples
+ * \return number of bytes
+ */
+size_t MQTTCoalescer::pending(const char *topic)
+{
+   slot_t *slot = find(topic, false);
+   return (slot != NULL) ? slot->len : 0;
+}
+
+//! \brief Returns the average number of samples carried by a publish
+/*!
+ * \return samples per publish, 0 if nothing has been published
+ */
+float MQTTCoalescer::samples_per_publish() const
+{
+   if(_stats.publishes == 0)
+   {
+      return 0;
+   }
+   return (float)_stats.samples / _stats.publishes;
+}
+
+//! \brief Searches the buffer of a topic
+/*!
+ * \param topic     topic of the buffer
+ * \param create    if true a free buffer is assigned to the topic when not found
+ * \return pointer to the buffer, NULL if not found or no buffer is free
+ */
+MQTTCoalescer::slot_t *MQTTCoalescer::find(const char *topic, bool create)
+{
+   if(topic == NULL || strlen(topic) >= MQTT_COALESCER_TOPIC_SIZE)
+   {
+      return NULL;
+   }
+   slot_t *unused = NULL;
+   for(int i = 0; i < MQTT_COALESCER_TOPICS; i++)
+   {
+      if(_slots[i].topic[0] == 0)
+      {
+         if(unused == NULL)
+         {
+            unused = &_slots[i];
+         }
+      }
+      else if(strcmp(_slots[i].topic, topic) == 0)
+      {
+         return &_slots[i];
+      }
+   }
+   if(create && unused != NULL)
+   {
+      strcpy(unused->topic, topic);
+      unused->len = 0;
+      unused->samples = 0;
+      return unused;
+   }
+   return NULL;
+}
+
+//! \brief Publishes a buffer
+/*! \details
+On success the buffer is emptied and its slot released, otherwise it is kept for the next flush.
+ * \param slot    buffer to publish
+ * \return return code
+ */
+ME310::return_t MQTTCoalescer::flush(slot_t &slot)
+{
+   ME310::return_t ret = _module.mqtt_publish_binary(_instance, slot.topic, _retain, _qos, slot.data, slot.len);
+   if(ret != ME310::RETURN_VALID)
+   {
+      _stats.failed++;
+      return ret;
+   }
+   /* fixed header (2), topic length (2), topic and packet identifier (2, QoS > 0 only) */
+   uint32_t header = 4 + strlen(slot.topic) + ((_qos > 0) ? 2 : 0);
+   _stats.publishes++;
+   _stats.samples += slot.samples;
+   _stats.bytes_saved += (slot.samples - 1) * header;
+   memset(&slot, 0, sizeof(slot));
+   return ret;
+}
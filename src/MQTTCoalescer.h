@@ -0,0 +1,111 @@
+/*Copyright (C) 2026 Telit Communications S.p.A. Italy - All Rights Reserved.*/
+/*    See LICENSE file in the project root for full license information.     */
+
+/**
+  @file
+    MQTTCoalescer.h
+
+  @brief
+    Coalescing publisher for MQTT telemetry
+
+  @details
+    The class appends the samples published on a topic into a per-topic buffer and publishes
+    the whole buffer with a single command, when it is full, when its oldest sample is too old
+    or on explicit request.\n
+    Buffers are fixed size arrays, no memory is allocated.
+
+  @version
+    2.13.1
+
+  @note
+    Dependencies:
+    ME310.h
+
+  @author
+
+  @date
+    18/10/2026
+*/
+#ifndef __MQTTCOALESCER__H
+#define __MQTTCOALESCER__H
+
+/* Include files ================================================================================*/
+#include "ME310.h"
+
+namespace me310
+{
+   #define MQTT_COALESCER_TOPICS 4            ///< Max number of topics coalesced at the same time
+   #define MQTT_COALESCER_TOPIC_SIZE 64       ///< Max topic length, including terminator
+   #define MQTT_COALESCER_BUFFSIZE 512        ///< Size of the buffer of each topic
+
+   /*! \class MQTTCoalescer
+      \brief Batches MQTT samples per topic
+      \details
+      Each call to add() appends a sample to the buffer of its topic, preceded by the separator if set.
+      The buffer is published with ME310::mqtt_publish_binary() when the next sample does not fit in the
+      flush size, when poll() finds that the oldest sample is older than the max age, or when flush()
+      is called. A buffer that fails to publish is kept and retried on the next flush.\n
+      The statistics report the samples carried by each publish and the bytes saved, computed as the
+      MQTT PUBLISH header bytes (fixed header, topic and packet identifier) not sent thanks to coalescing.
+   */
+   class MQTTCoalescer
+   {
+      public:
+
+      /*! \struct stats_t
+         \brief Coalescing statistics
+      */
+      typedef struct
+      {
+         uint32_t samples;         ///< Number of samples published
+         uint32_t publishes;       ///< Number of publishes
+         uint32_t failed;          ///< Number of failed publishes
+         uint32_t dropped;         ///< Number of samples dropped because they did not fit in a buffer
+         uint32_t bytes_saved;     ///< MQTT header bytes saved by coalescing
+      } stats_t;
+
+      MQTTCoalescer(ME310 &module, int instanceNumber, int qos = 0, int retain = 0);
+
+      void set_flush_size(size_t size);
+      void set_max_age(uint32_t ms) { _maxAge = ms; }          //!< Sets the max age in ms of a buffered sample, 0 to disable
+      void set_separator(int separator) { _separator = separator; }   //!< Sets the byte appended between samples, -1 for none
+
+      ME310::return_t add(const char *topic, const uint8_t *data, size_t len);
+      ME310::return_t add(const char *topic, const char *data);
+      ME310::return_t poll();
+      ME310::return_t flush();
+      ME310::return_t flush(const char *topic);
+      void clear();
+
+      size_t pending(const char *topic);
+      const stats_t &statistics() const { return _stats; }      //!< Returns the coalescing statistics
+      void reset_statistics() { memset(&_stats, 0, sizeof(_stats)); }   //!< Resets the coalescing statistics
+      float samples_per_publish() const;
+
+      private:
+
+      typedef struct
+      {
+         char topic[MQTT_COALESCER_TOPIC_SIZE];   //!< Topic, empty if the slot is free
+         uint8_t data[MQTT_COALESCER_BUFFSIZE];    //!< Buffered samples
+         size_t len;                               //!< Used size of data
+         uint16_t samples;                         //!< Number of buffered samples
+         uint32_t first;                           //!< Time in ms of the oldest buffered sample
+      } slot_t;
+
+      slot_t *find(const char *topic, bool create);
+      ME310::return_t flush(slot_t &slot);
+
+      ME310 &_module;                           //!< Module used to publish
+      int _instance;                            //!< MQTT client instance
+      int _qos;                                 //!< QoS of the publishes
+      int _retain;                              //!< Retain flag of the publishes
+      size_t _flushSize;                        //!< Buffer size that triggers a publish
+      uint32_t _maxAge;                         //!< Max age in ms of a buffered sample
+      int _separator;                           //!< Byte appended between samples, -1 for none
+      slot_t _slots[MQTT_COALESCER_TOPICS];     //!< Per-topic buffers
+      stats_t _stats;                           //!< Coalescing statistics
+   };
+} // end namespace
+
+#endif //__MQTTCOALESCER__H
@@ -0,0 +1,326 @@
+/*Copyright (C) 2026 Telit Communications S.p.A. Italy - All Rights Reserved.*/
+/*    See LICENSE file in the project root for full license information.     */
+
+/**
+  @file
+    MQTTRouter.cpp
+
+  @brief
+    Topic router for MQTT messages
+
+  @details
+    The class compiles MQTT topic filters, including + and # wildcards, into a trie and dispatches the
+    received messages to the handlers registered for the matching filters.\n
+
+  @version
+    2.13.1
+
+  @note
+    Dependencies:
+    MQTTRouter.h
+
+  @author
+
+  @date
+    18/10/2026
+*/
+
+#include "MQTTRouter.h"
+#include <string.h>
+
+using namespace me310;
+
+//! \brief Class Constructor
+/*!
+ */
+MQTTRouter::MQTTRouter()
+{
+   clear();
+}
+
+//! \brief Removes all the topic filters
+/*!
+ */
+void MQTTRouter::clear()
+{
+   _nodeCount = 0;
+   _namesLen = 0;
+   newNode(NULL, 0);
+}
+
+//! \brief Adds a topic filter
+/*! \details
+The handler replaces the one previously registered for the same filter.
+ * \param filter    topic filter, may contain + and # wildcards
+ * \param handler   function called for each message matching the filter
+ * \param context   pointer passed back to the handler
+ * \return true if the filter was added, false if it is not valid or there is no room left
+ */
+bool MQTTRouter::add(const char *filter, handler_t handler, void *context)
+{
+   if(filter == NULL || handler == NULL)
+   {
+      return false;
+   }
+   int node = 0;
+   const char *level = filter;
+   while(true)
+   {
+      const char *end = strchr(level, '/');
+      size_t len = (end != NULL) ? (size_t)(end - level) : strlen(level);
+      int child;
+      if(len == 1 && level[0] == '#')
+      {
+         if(end != NULL)
+         {
+            return false;
+         }
+         if(_nodes[node].hashChild < 0)
+         {
+            child = newNode(NULL, 0);
+            if(child < 0)
+            {
+               return false;
+            }
+            _nodes[node].hashChild = child;
+         }
+         child = _nodes[node].hashChild;
+      }
+      else if(len == 1 && level[0] == '+')
+      {
+         if(_nodes[node].plusChild < 0)
+         {
+            child = newNode(NULL, 0);
+            if(child < 0)
+            {
+               return false;
+            }
+            _nodes[node].plusChild = child;
+         }
+         child = _nodes[node].plusChild;
+      }
+      else
+      {
+         if(memchr(level, '+', len) != NULL || memchr(level, '#', len) != NULL)
+         {
+            return false;
+         }
+         child = findChild(node, level, len);
+         if(child < 0)
+         {
+            child = newNode(level, len);
+            if(child < 0)
+            {
+               return false;
+            }
+            _nodes[child].nextSibling = _nodes[node].firstChild;
+            _nodes[node].firstChild = child;
+         }
+      }
+      node = child;
+      if(end == NULL)
+      {
+         break;
+      }
+      level = end + 1;
+   }
+   _nodes[node].handler = handler;
+   _nodes[node].context = context;
+   return true;
+}
+
+//! \brief Removes a topic filter
+/*! \details
+The trie nodes of the filter are kept and reused if the filter is added again.
+ * \param filter    topic filter, as passed to add()
+ * \return true if the filter was registered
+ */
+bool MQTTRouter::remove(const char *filter)
+{
+   int node = findNode(filter);
+   if(node < 0 || _nodes[node].handler == NULL)
+   {
+      return false;
+   }
+   _nodes[node].handler = NULL;
+   _nodes[node].context = NULL;
+   return true;
+}
+
+//! \brief Dispatches a message to the handlers of the matching filters
+/*!
+ * \param message    message read from the module
+ * \return number of handlers called
+ */
+int MQTTRouter::dispatch(const ME310::mqtt_message_t &message)
+{
+   if(message.topic == NULL)
+   {
+      return 0;
+   }
+   return match(0, message.topic, true, message);
+}
+
+//! \brief Dispatches a message to the handlers of the matching filters
+/*!
+ * \param topic      topic the message was published to
+ * \param payload    message payload
+ * \param len        payload length in bytes
+ * \return number of handlers called
+ */
+int MQTTRouter::dispatch(const char *topic, const uint8_t *payload, int len)
+{
+   ME310::mqtt_message_t message;
+   message.instance = 0;
+   message.mId = 0;
+   message.topic = topic;
+   message.payload = payload;
+   message.len = len;
+   return dispatch(message);
+}
+
+//! \brief Allocates a node from the node array
+/*!
+ * \param name    level name, NULL for wildcard nodes
+ * \param len     level name length
+ * \return node index, -1 if there is no room left
+ */
+int MQTTRouter::newNode(const char *name, size_t len)
+{
+   if(_nodeCount >= MQTT_ROUTER_MAX_NODES || _namesLen + len > MQTT_ROUTER_NAMES_SIZE || len > 0xFF)
+   {
+      return -1;
+   }
+   node_t &node = _nodes[_nodeCount];
+   node.name = _namesLen;
+   node.nameLen = len;
+   node.firstChild = -1;
+   node.nextSibling = -1;
+   node.plusChild = -1;
+   node.hashChild = -1;
+   node.handler = NULL;
+   node.context = NULL;
+   if(len > 0)
+   {
+      memcpy(_names + _namesLen, name, len);
+      _namesLen += len;
+   }
+   return _nodeCount++;
+}
+
+//! \brief Searches a child with a literal level name
+/*!
+ * \param node    parent node index
+ * \param name    level name, not null terminated
+ * \param len     level name length
+ * \return child node index, -1 if not found
+ */
+int MQTTRouter::findChild(int node, const char *name, size_t len)
+{
+   for(int child = _nodes[node].firstChild; child >= 0; child = _nodes[child].nextSibling)
+   {
+      if(_nodes[child].nameLen == len && memcmp(_names + _nodes[child].name, name, len) == 0)
+      {
+         return child;
+      }
+   }
+   return -1;
+}
+
+//! \brief Searches the node where a topic filter ends
+/*!
+ * \param filter    topic filter
+ * \return node index, -1 if the filter is not in the trie
+ */
+int MQTTRouter::findNode(const char *filter)
+{
+   if(filter == NULL)
+   {
+      return -1;
+   }
+   int node = 0;
+   const char *level = filter;
+   while(node >= 0)
+   {
+      const char *end = strchr(level, '/');
+      size_t len = (end != NULL) ? (size_t)(end - level) : strlen(level);
+      if(len == 1 && level[0] == '#')
+      {
+         node = _nodes[node].hashChild;
+      }
+      else if(len == 1 && level[0] == '+')
+      {
+         node = _nodes[node].plusChild;
+      }
+      else
+      {
+         node = findChild(node, level, len);
+      }
+      if(end == NULL)
+      {
+         break;
+      }
+      level = end + 1;
+   }
+   return node;
+}
+
+//! \brief Calls the handler of a node, if any
+/*!
+ * \param node       node index
+ * \param message    message to dispatch
+ * \return 1 if the handler was called, 0 otherwise
+ */
+int MQTTRouter::call(int node, const ME310::mqtt_message_t &message)
+{
+   if(_nodes[node].handler == NULL)
+   {
+      return 0;
+   }
+   _nodes[node].handler(message, _nodes[node].context);
+   return 1;
+}
+
+//! \brief Matches the remaining topic levels from a node
+/*!
+ * \param node       current node index
+ * \param level      start of the current topic level, NULL if all the levels were matched
+ * \param first      true if level is the first level of the topic
+ * \param message    message to dispatch
+ * \return number of handlers called
+ */
+int MQTTRouter::match(int node, const char *level, bool first, const ME310::mqtt_message_t &message)
+{
+   int count = 0;
+   if(level == NULL)
+   {
+      count += call(node, message);
+      /* "a/#" matches "a" too */
+      if(_nodes[node].hashChild >= 0)
+      {
+         count += call(_nodes[node].hashChild, message);
+      }
+      return count;
+   }
+   const char *end = strchr(level, '/');
+   size_t len = (end != NULL) ? (size_t)(end - level) : strlen(level);
+   const char *next = (end != NULL) ? end + 1 : NULL;
+
+   if(!(first && level[0] == '$'))
+   {
+      if(_nodes[node].hashChild >= 0)
+      {
+         count += call(_nodes[node].hashChild, message);
+      }
+      if(_nodes[node].plusChild >= 0)
+      {
+         count += match(_nodes[node].plusChild, next, false, message);
+      }
+   }
+   int child = findChild(node, level, len);
+   if(child >= 0)
+   {
+      count += match(child, next, false, message);
+   }
+   return count;
+}
@@ -0,0 +1,90 @@
+/*Copyright (C) 2026 Telit Communications S.p.A. Italy - All Rights Reserved.*/
+/*    See LICENSE file in the project root for full license information.     */
+
+/**
+  @file
+    MQTTRouter.h
+
+  @brief
+    Topic router for MQTT messages
+
+  @details
+    The class compiles MQTT topic filters, including + and # wildcards, into a trie and dispatches the
+    received messages to the handlers registered for the matching filters.\n
+    Nodes and level names are stored in fixed size arrays, no memory is allocated.
+
+  @version
+    2.13.1
+
+  @note
+    Dependencies:
+    ME310.h
+
+  @author
+
+  @date
+    18/10/2026
+*/
+#ifndef __MQTTROUTER__H
+#define __MQTTROUTER__H
+
+/* Include files ================================================================================*/
+#include "ME310.h"
+
+namespace me310
+{
+   #define MQTT_ROUTER_MAX_NODES 48         ///< Max number of trie nodes (one per topic level)
+   #define MQTT_ROUTER_NAMES_SIZE 384       ///< Size of the buffer storing the topic level names
+
+   /*! \class MQTTRouter
+      \brief Routes MQTT messages to handlers by topic filter
+      \details
+      Topic filters follow MQTT rules: + matches exactly one level, # matches any number of levels and
+      must be the last level of the filter. Wildcards at the first level do not match topics starting with $.\n
+      A received topic is matched walking the trie level by level, so the cost depends on the topic length
+      and not on the number of subscriptions.\n
+      The router can be attached to the driver with ME310::mqtt_set_router(), so that the messages read by
+      ME310::mqtt_process_messages() are dispatched automatically.
+   */
+   class MQTTRouter
+   {
+      public:
+
+      typedef void (*handler_t)(const ME310::mqtt_message_t &message, void *context);   //!< Message handler
+
+      MQTTRouter();
+
+      bool add(const char *filter, handler_t handler, void *context = NULL);
+      bool remove(const char *filter);
+      void clear();
+      int dispatch(const ME310::mqtt_message_t &message);
+      int dispatch(const char *topic, const uint8_t *payload, int len);
+
+      private:
+
+      typedef struct
+      {
+         uint16_t name;        //!< Offset of the level name in _names
+         uint8_t nameLen;      //!< Length of the level name
+         int16_t firstChild;   //!< First child with a literal level name
+         int16_t nextSibling;  //!< Next sibling with a literal level name
+         int16_t plusChild;    //!< Child for the + wildcard
+         int16_t hashChild;    //!< Child for the # wildcard
+         handler_t handler;    //!< Handler of the filter ending at this node
+         void *context;        //!< Handler context
+      } node_t;
+
+      int newNode(const char *name, size_t len);
+      int findChild(int node, const char *name, size_t len);
+      int findNode(const char *filter);
+      int call(int node, const ME310::mqtt_message_t &message);
+      int match(int node, const char *level, bool first, const ME310::mqtt_message_t &message);
+
+      node_t _nodes[MQTT_ROUTER_MAX_NODES];    //!< Trie nodes, the first one is the root
+      int _nodeCount;                          //!< Number of used nodes
+      char _names[MQTT_ROUTER_NAMES_SIZE];     //!< Level names
+      size_t _namesLen;                        //!< Used size of level names buffer
+   };
+} // end namespace
+
+#endif //__MQTTROUTER__H
@@ -0,0 +1,416 @@
+/*Copyright (C) 2026 Telit Communications S.p.A. Italy - All Rights Reserved.*/
+/*    See LICENSE file in the project root for full license information.     */
+
+/**
+  @file
+    NMEAParser.cpp
+
+  @brief
+    Streaming parser of the NMEA sentences of the GNSS unsolicited stream
+
+  @details
+    The class decodes the GGA, RMC, GSA, GSV, VTG and GNS sentences enabled with AT$GPSNMUN and
+    AT$GPSNMUNEX one byte at a time, validates their checksum and merges them in a fix with fixed
+    point coordinates, published to a callback once per epoch.\n
+
+  @version
+    2.13.1
+
+  @note
+    Dependencies:
+    NMEAParser.h
+
+  @author
+
+  @date
+    18/10/2026
+*/
+
+#include "NMEAParser.h"
+
+using namespace me310;
+
+#define NMEA_NO_TIME 0xFFFFFFFFUL   ///< Sentence without UTC time
+
+//! \brief Class Constructor
+/*!
+ * \param handler    function receiving the published fixes, may be NULL
+ * \param context    pointer passed back to the handler
+ */
+NMEAParser::NMEAParser(handler_t handler, void *context) : _handler(handler), _context(context), _trigger(0)
+{
+   reset();
+}
+
+//! \brief Clears the fix and the tokenizer state
+void NMEAParser::reset()
+{
+   memset(&_fix, 0, sizeof(_fix));
+   memset(_inView, 0, sizeof(_inView));
+   _epoch = NMEA_NO_TIME;
+   _state = STATE_IDLE;
+   _count = 0;
+   _errors = 0;
+}
+
+//! \brief Parses a character of the stream
+/*!
+ * \param c    character received
+ * \return true if a handled sentence with valid checksum has been completed
+ */
+bool NMEAParser::feed(char c)
+{
+   if(c == '$')
+   {
+      _state = STATE_DATA;
+      _work = _fix;
+      _type = 0;
+      _time = NMEA_NO_TIME;
+      _gsvInView = -1;
+      _sum = 0;
+      _field = 0;
+      _len = 0;
+      _overflow = false;
+      return false;
+   }
+   int h;
+   switch(_state)
+   {
+      case STATE_DATA:
+         if(c == '*')
+         {
+            field();
+            _state = STATE_CHECKSUM_HIGH;
+         }
+         else if(c == '\r' || c == '\n')
+         {
+            _errors++;
+            _state = STATE_IDLE;
+         }
+         else
+         {
+            _sum ^= (uint8_t)c;
+            if(c == ',')
+            {
+               field();
+               _field++;
+               _len = 0;
+            }
+            else if(_len < NMEA_FIELD_SIZE - 1)
+            {
+               _buf[_len++] = c;
+            }
+            else
+            {
+               _overflow = true;
+            }
+         }
+         return false;
+
+      case STATE_CHECKSUM_HIGH:
+         h = hex(c);
+         _checksum = (uint8_t)(h << 4);
+         _state = (h < 0) ? STATE_IDLE : STATE_CHECKSUM_LOW;
+         if(h < 0)
+         {
+            _errors++;
+         }
+         return false;
+
+      case STATE_CHECKSUM_LOW:
+         h = hex(c);
+         _state = STATE_IDLE;
+         if(h < 0 || (_checksum | h) != _sum || _overflow)
+         {
+            _errors++;
+            return false;
+         }
+         if(_type == 0)
+         {
+            return false;
+         }
+         commit();
+         return true;
+
+      default:
+         return false;
+   }
+}
+
+//! \brief Parses a text of the stream
+/*!
+ * \param text    null terminated text, with one or more sentences
+ * \return number of handled sentences with valid checksum
+ */
+int NMEAParser::feed(const char *text)
+{
+   int count = 0;
+   while(text != NULL && *text != 0)
+   {
+      if(feed(*text++))
+      {
+         count++;
+      }
+   }
+   return count;
+}
+
+//! \brief Publishes the fix of the current epoch to the handler
+/*! \details
+Nothing is published if no sentence has been received since the last publication.
+ */
+void NMEAParser::publish()
+{
+   if(_fix.sentences != 0 && _handler != NULL)
+   {
+      _handler(_fix, _context);
+   }
+   _fix.sentences = 0;
+}
+
+//! \brief Checks if a line is a NMEA sentence
+/*!
+ * \param line    line received, with or without line terminator
+ * \return true if the line starts with '$' and ends with a checksum
+ */
+bool NMEAParser::is_sentence(const char *line)
+{
+   if(line == NULL || line[0] != '$')
+   {
+      return false;
+   }
+   const char *star = strchr(line, '*');
+   return star != NULL && hex(star[1]) >= 0 && hex(star[2]) >= 0 &&
+          (star[3] == 0 || star[3] == '\r' || star[3] == '\n');
+}
+
+//! \brief Decodes the field just ended
+void NMEAParser::field()
+{
+   _buf[_len] = 0;
+   if(_overflow)
+   {
+      return;
+   }
+   if(_field == 0)
+   {
+      /* address: talker and sentence formatter, e.g. GPGGA */
+      if(_len != 5 || _buf[0] != 'G')
+      {
+         return;
+      }
+      const char *formatter = _buf + 2;
+      if(strcmp(formatter, "GGA") == 0) _type = NMEA_GGA;
+      else if(strcmp(formatter, "RMC") == 0) _type = NMEA_RMC;
+      else if(strcmp(formatter, "GSA") == 0) _type = NMEA_GSA;
+      else if(strcmp(formatter, "GSV") == 0) _type = NMEA_GSV;
+      else if(strcmp(formatter, "VTG") == 0) _type = NMEA_VTG;
+      else if(strcmp(formatter, "GNS") == 0) _type = NMEA_GNS;
+      _gsvTalker = (_buf[1] == 'P') ? 0 : (_buf[1] == 'L') ? 1 : (_buf[1] == 'A') ? 2 : 3;
+      return;
+   }
+   bool empty = (_len == 0);
+   switch(_type)
+   {
+      case NMEA_GGA:
+         /* time,lat,N,lon,E,quality,satellites,hdop,altitude,M,... */
+         switch(_field)
+         {
+            case 1: _time = utc(_buf, _work); break;
+            case 2: if(!empty) _work.latitude = coordinate(_buf); break;
+            case 3: if(!empty && (_buf[0] == 'S') == (_work.latitude > 0)) _work.latitude = -_work.latitude; break;
+            case 4: if(!empty) _work.longitude = coordinate(_buf); break;
+            case 5: if(!empty && (_buf[0] == 'W') == (_work.longitude > 0)) _work.longitude = -_work.longitude; break;
+            case 6: _work.quality = (uint8_t)atoi(_buf); _work.valid = (_work.quality > 0); break;
+            case 7: if(!empty) _work.satellites = (uint8_t)atoi(_buf); break;
+            case 8: if(!empty) _work.hdop = (uint16_t)decimal(_buf, 2); break;
+            case 9: if(!empty) _work.altitude = decimal(_buf, 2); break;
+         }
+         break;
+
+      case NMEA_RMC:
+         /* time,status,lat,N,lon,E,speed,course,date,... */
+         switch(_field)
+         {
+            case 1: _time = utc(_buf, _work); break;
+            case 2: _work.valid = (_buf[0] == 'A'); break;
+            case 3: if(!empty) _work.latitude = coordinate(_buf); break;
+            case 4: if(!empty && (_buf[0] == 'S') == (_work.latitude > 0)) _work.latitude = -_work.latitude; break;
+            case 5: if(!empty) _work.longitude = coordinate(_buf); break;
+            case 6: if(!empty && (_buf[0] == 'W') == (_work.longitude > 0)) _work.longitude = -_work.longitude; break;
+            case 7: if(!empty) _work.speed = (uint32_t)decimal(_buf, 3); break;
+            case 8: if(!empty) _work.course = (uint16_t)decimal(_buf, 2); break;
+            case 9:
+               if(_len == 6)
+               {
+                  _work.day = (uint8_t)((_buf[0] - '0') * 10 + (_buf[1] - '0'));
+                  _work.month = (uint8_t)((_buf[2] - '0') * 10 + (_buf[3] - '0'));
+                  _work.year = (uint16_t)((_buf[4] - '0') * 10 + (_buf[5] - '0'));
+                  _work.year += (_work.year < 80) ? 2000 : 1900;
+               }
+               break;
+         }
+         break;
+
+      case NMEA_GSA:
+         /* mode,type,12 satellites,pdop,hdop,vdop */
+         switch(_field)
+         {
+            case 2: if(!empty) _work.type = (uint8_t)atoi(_buf); break;
+            case 15: if(!empty) _work.pdop = (uint16_t)decimal(_buf, 2); break;
+            case 16: if(!empty) _work.hdop = (uint16_t)decimal(_buf, 2); break;
+            case 17: if(!empty) _work.vdop = (uint16_t)decimal(_buf, 2); break;
+         }
+         break;
+
+      case NMEA_GSV:
+         /* messages,message,in view,... */
+         if(_field == 3 && !empty)
+         {
+            _gsvInView = atoi(_buf);
+         }
+         break;
+
+      case NMEA_VTG:
+         /* course,T,course,M,speed,N,speed,K,mode */
+         switch(_field)
+         {
+            case 1: if(!empty) _work.course = (uint16_t)decimal(_buf, 2); break;
+            case 5: if(!empty) _work.speed = (uint32_t)decimal(_buf, 3); break;
+         }
+         break;
+
+      case NMEA_GNS:
+         /* time,lat,N,lon,E,mode,satellites,hdop,altitude,... */
+         switch(_field)
+         {
+            case 1: _time = utc(_buf, _work); break;
+            case 2: if(!empty) _work.latitude = coordinate(_buf); break;
+            case 3: if(!empty && (_buf[0] == 'S') == (_work.latitude > 0)) _work.latitude = -_work.latitude; break;
+            case 4: if(!empty) _work.longitude = coordinate(_buf); break;
+            case 5: if(!empty && (_buf[0] == 'W') == (_work.longitude > 0)) _work.longitude = -_work.longitude; break;
+            case 6:
+               /* one mode character for each constellation, N means no fix */
+               _work.valid = false;
+               for(int i = 0; i < _len; i++)
+               {
+                  if(_buf[i] != 'N')
+                  {
+                     _work.valid = true;
+                  }
+               }
+               break;
+            case 7: if(!empty) _work.satellites = (uint8_t)atoi(_buf); break;
+            case 8: if(!empty) _work.hdop = (uint16_t)decimal(_buf, 2); break;
+            case 9: if(!empty) _work.altitude = decimal(_buf, 2); break;
+         }
+         break;
+   }
+}
+
+//! \brief Merges the sentence just validated in the fix and publishes it if needed
+void NMEAParser::commit()
+{
+   _count++;
+   if(_type == NMEA_GSV && _gsvInView >= 0)
+   {
+      _inView[_gsvTalker] = (uint8_t)_gsvInView;
+      int sum = 0;
+      for(int i = 0; i < NMEA_TALKERS; i++)
+      {
+         sum += _inView[i];
+      }
+      _work.in_view = (uint8_t)(sum > 255 ? 255 : sum);
+   }
+   if(_trigger == 0 && _time != NMEA_NO_TIME && _time != _epoch)
+   {
+      /* first sentence of a new epoch: the previous one is complete */
+      publish();
+      _work.sentences = 0;
+      _epoch = _time;
+   }
+   _work.sentences |= _type;
+   _fix = _work;
+   if(_trigger & _type)
+   {
+      publish();
+   }
+}
+
+//! \brief Converts a decimal number to fixed point
+/*!
+ * \param text        number, e.g. "-12.345"
+ * \param decimals    number of decimals of the result, extra digits are truncated
+ * \return the number multiplied by 10^decimals
+ */
+int32_t NMEAParser::decimal(const char *text, int decimals)
+{
+   bool negative = (*text == '-');
+   if(negative || *text == '+')
+   {
+      text++;
+   }
+   int32_t value = 0;
+   while(*text >= '0' && *text <= '9')
+   {
+      value = value * 10 + (*text++ - '0');
+   }
+   if(*text == '.')
+   {
+      text++;
+   }
+   for(int i = 0; i < decimals; i++)
+   {
+      value *= 10;
+      if(*text >= '0' && *text <= '9')
+      {
+         value += *text++ - '0';
+      }
+   }
+   return negative ? -value : value;
+}
+
+//! \brief Converts a NMEA coordinate to fixed point
+/*!
+ * \param text    coordinate as (d)ddmm.mmmmm
+ * \return coordinate in 1e-7 degrees, positive
+ */
+int32_t NMEAParser::coordinate(const char *text)
+{
+   int32_t minutes = decimal(text, 5);            /* dddmm.mmmmm * 10^5 */
+   int32_t degrees = minutes / 10000000L;
+   minutes -= degrees * 10000000L;                 /* mm.mmmmm * 10^5 */
+   return degrees * 10000000L + (minutes * 10 + 3) / 6;
+}
+
+//! \brief Decodes a UTC time field
+/*!
+ * \param text    time as hhmmss.sss
+ * \param fix     receives hour, minute, second and millisecond
+ * \return time as hhmmss * 1000 + ms, NMEA_NO_TIME if the field is empty
+ */
+uint32_t NMEAParser::utc(const char *text, fix_t &fix)
+{
+   if(strlen(text) < 6)
+   {
+      return NMEA_NO_TIME;
+   }
+   fix.hour = (uint8_t)((text[0] - '0') * 10 + (text[1] - '0'));
+   fix.minute = (uint8_t)((text[2] - '0') * 10 + (text[3] - '0'));
+   fix.second = (uint8_t)((text[4] - '0') * 10 + (text[5] - '0'));
+   fix.millisecond = (uint16_t)(decimal(text + 6, 3));
+   return ((uint32_t)fix.hour * 10000UL + fix.minute * 100UL + fix.second) * 1000UL + fix.millisecond;
+}
+
+//! \brief Converts a hexadecimal digit
+/*!
+ * \param c    digit
+ * \return digit value, -1 if c is not a hexadecimal digit
+ */
+int NMEAParser::hex(char c)
+{
+   if(c >= '0' && c <= '9') return c - '0';
+   if(c >= 'A' && c <= 'F') return c - 'A' + 10;
+   if(c >= 'a' && c <= 'f') return c - 'a' + 10;
+   return -1;
+}
@@ -0,0 +1,151 @@
+/*Copyright (C) 2026 Telit Communications S.p.A. Italy - All Rights Reserved.*/
+/*    See LICENSE file in the project root for full license information.     */
+
+/**
+  @file
+    NMEAParser.h
+
+  @brief
+    Streaming parser of the NMEA sentences of the GNSS unsolicited stream
+
+  @details
+    The class decodes the GGA, RMC, GSA, GSV, VTG and GNS sentences enabled with AT$GPSNMUN and
+    AT$GPSNMUNEX one byte at a time, validates their checksum and merges them in a fix with fixed
+    point coordinates, published to a callback once per epoch.\n
+    No memory is allocated, the sentence is never stored: each field is decoded when it ends.
+
+  @version
+    2.13.1
+
+  @note
+    Dependencies:
+    ME310.h
+
+  @author
+
+  @date
+    18/10/2026
+*/
+#ifndef __NMEAPARSER__H
+#define __NMEAPARSER__H
+
+/* Include files ================================================================================*/
+#include "ME310.h"
+
+namespace me310
+{
+   #define NMEA_FIELD_SIZE 16     ///< Max length of a sentence field, longer fields invalidate the sentence
+   #define NMEA_TALKERS 4         ///< Satellites in view are counted for GP, GL, GA and the other talkers
+
+   /*! \class NMEAParser
+      \brief Byte fed NMEA tokenizer
+      \details
+      Sentences update the fix only when their checksum is valid. Fields left empty by the receiver keep the
+      previous value, so the valid flag must be checked before using the position.\n
+      By default the fix of an epoch is published when a sentence with a different UTC time is received, that
+      is one epoch later; set_trigger() publishes it as soon as the given sentence, usually the last one of the
+      epoch in the configured stream, is received.\n
+      The parser can be attached to the driver with ME310::gnss_set_nmea_parser(), so that the sentences received
+      as unsolicited lines are parsed in the URC path: the handler is then called while the driver is reading
+      and must not send commands.
+   */
+   class NMEAParser
+   {
+      public:
+
+      typedef enum
+      {
+         NMEA_GGA = 0x01,
+         NMEA_RMC = 0x02,
+         NMEA_GSA = 0x04,
+         NMEA_GSV = 0x08,
+         NMEA_VTG = 0x10,
+         NMEA_GNS = 0x20
+      } sentence_t;
+
+      /*! \struct fix_t
+         \brief Fix merged from the sentences of an epoch
+      */
+      typedef struct
+      {
+         bool valid;                   ///< Position valid, from RMC status, GGA quality or GNS mode
+         uint8_t quality;              ///< GGA fix quality, 0 if not available
+         uint8_t type;                 ///< GSA fix type, 1 no fix, 2 2D, 3 3D
+         uint8_t satellites;           ///< Satellites used
+         uint8_t in_view;              ///< Satellites in view, sum of the GSV of all the talkers
+         uint8_t hour;                 ///< UTC hour
+         uint8_t minute;               ///< UTC minute
+         uint8_t second;               ///< UTC second
+         uint16_t millisecond;         ///< UTC millisecond
+         uint8_t day;                  ///< UTC day, 0 if RMC is not received
+         uint8_t month;                ///< UTC month
+         uint16_t year;                ///< UTC year
+         int32_t latitude;             ///< Latitude, in 1e-7 degrees, north positive
+         int32_t longitude;            ///< Longitude, in 1e-7 degrees, east positive
+         int32_t altitude;             ///< Altitude above mean sea level, in cm
+         uint16_t hdop;                ///< Horizontal dilution of precision, in 1/100
+         uint16_t pdop;                ///< Position dilution of precision, in 1/100
+         uint16_t vdop;                ///< Vertical dilution of precision, in 1/100
+         uint32_t speed;               ///< Speed over ground, in 1/1000 knot
+         uint16_t course;              ///< Course over ground, in 1/100 degree
+         uint8_t sentences;            ///< Sentences received in the epoch, mask of sentence_t
+      } fix_t;
+
+      typedef void (*handler_t)(const fix_t &fix, void *context);   //!< Receives the published fixes
+
+      NMEAParser(handler_t handler = NULL, void *context = NULL);
+
+      void set_handler(handler_t handler, void *context = NULL) { _handler = handler; _context = context; }   //!< Sets the fix handler
+      void set_trigger(uint8_t sentence) { _trigger = sentence; }   //!< Publishes the fix after the given sentence_t, 0 on UTC time change
+      bool feed(char c);
+      int feed(const char *text);
+      void publish();
+      void reset();
+
+      const fix_t &fix() const { return _fix; }       //!< Returns the fix of the current epoch
+      uint32_t sentences() const { return _count; }   //!< Returns the number of valid sentences
+      uint32_t errors() const { return _errors; }     //!< Returns the number of sentences with bad checksum or format
+
+      static bool is_sentence(const char *line);
+      static int32_t decimal(const char *text, int decimals);
+      static int32_t coordinate(const char *text);
+
+      private:
+
+      typedef enum
+      {
+         STATE_IDLE = 0,
+         STATE_DATA,
+         STATE_CHECKSUM_HIGH,
+         STATE_CHECKSUM_LOW
+      } state_t;
+
+      void field();
+      void commit();
+      static uint32_t utc(const char *text, fix_t &fix);
+      static int hex(char c);
+
+      handler_t _handler;             //!< Fix handler
+      void *_context;                 //!< Pointer passed back to the handler
+      uint8_t _trigger;               //!< Sentence publishing the fix, 0 on time change
+      fix_t _fix;                     //!< Fix of the current epoch
+      fix_t _work;                    //!< Fix updated by the sentence being parsed
+      uint32_t _epoch;                //!< UTC time of the current epoch, hhmmss * 1000 + ms
+      uint32_t _time;                 //!< UTC time of the sentence being parsed, 0xFFFFFFFF if none
+      uint8_t _inView[NMEA_TALKERS];  //!< Satellites in view of each talker
+      int _gsvTalker;                 //!< Talker of the GSV sentence being parsed
+      int _gsvInView;                 //!< Satellites in view of the GSV sentence being parsed
+      state_t _state;                 //!< Tokenizer state
+      uint8_t _type;                  //!< Sentence being parsed, 0 if not handled
+      uint8_t _sum;                   //!< Running checksum
+      uint8_t _checksum;              //!< Received checksum
+      uint8_t _field;                 //!< Index of the field being parsed
+      uint8_t _len;                   //!< Length of the field being parsed
+      bool _overflow;                 //!< A field exceeded NMEA_FIELD_SIZE
+      char _buf[NMEA_FIELD_SIZE];     //!< Field being parsed
+      uint32_t _count;                //!< Valid sentences
+      uint32_t _errors;               //!< Bad sentences
+   };
+} // end namespace
+
+#endif //__NMEAPARSER__H
@@ -563,36 +563,18 @@ namespace telitAT
     */
     int MQREADParser::findPayloadStart()
     {
-        string tmp_str;
-        tmp_str = _rawData;
-        size_t posNewRow = tmp_str.find_first_of("\n");
+        size_t posNewRow = _rawData.find_first_of("\n");
         if(posNewRow != string::npos)
         {
-            size_t posSecondNewRow = tmp_str.find_first_of("\n", posNewRow+1);
+            size_t posSecondNewRow = _rawData.find_first_of("\n", posNewRow+1);
             if(posSecondNewRow != string::npos)
             {
-                size_t posMaj = tmp_str.find_first_of("<", posSecondNewRow + 1);
-                if(posMaj != string::npos)
-                {
-                    size_t posMaj2 = tmp_str.find_first_of("<", posMaj + 1);
-                    if(posMaj2 != string::npos)
-                    {
-                        size_t posMaj3 = tmp_str.find_first_of("<", posMaj2+1);
-                        if(posMaj3 != string::npos)
-                        {
-                            posMaj3++;
-                        }
-                        return posMaj3;
-                    }
-                    else
-                    {
-                        return posMaj2;
-                    }
-                }
-                else
+                size_t posSequence = _rawData.find("<<<", posSecondNewRow + 1);
+                if(posSequence != string::npos)
                 {
-                    return posMaj;
+                    posSequence += 3;
                 }
+                return posSequence;
             }
             else
             {
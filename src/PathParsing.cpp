@@ -86,7 +86,8 @@ namespace telitAT
 
     //! \brief Gets the file size
     /*! \details
-    Returns the size of the file identified in the list. The file name is the one identified in the constructor.
+    Returns the size of the file identified in the list. The file name is the one identified in the constructor,
+    it is compared with whole entry names, so a file whose name is the suffix of another one is not mismatched.
     The value of the size is an integer, if the file is not found, -1 is returned.
     * \param list list to parse.
     * \return file size
@@ -99,8 +100,20 @@ namespace telitAT
             str = list;
             char sizeFile[16];
 
-            int posFilename = str.rfind(_filename);
-            if(posFilename != string::npos)
+            /* the name must be a whole entry name: "name", or name, at the start of the entry */
+            size_t nameLen = strlen(_filename);
+            size_t posFilename = str.rfind(_filename);
+            while(posFilename != string::npos)
+            {
+                char before = (posFilename > 0) ? str[posFilename - 1] : '\n';
+                char after = (posFilename + nameLen < str.length()) ? str[posFilename + nameLen] : '\0';
+                if((before == '"' || before == ' ' || before == '\n') && (after == '"' || after == ','))
+                {
+                    break;
+                }
+                posFilename = (posFilename > 0) ? str.rfind(_filename, posFilename - 1) : string::npos;
+            }
+            if(posFilename != string::npos && nameLen > 0)
             {
                 int posComma =  str.find_first_of(",", posFilename);
                 int posNewRow = str.find_first_of("\n", posComma);
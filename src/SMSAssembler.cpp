@@ -0,0 +1,396 @@
+/*Copyright (C) 2026 Telit Communications S.p.A. Italy - All Rights Reserved.*/
+/*    See LICENSE file in the project root for full license information.     */
+
+/**
+  @file
+    SMSAssembler.cpp
+
+  @brief
+    Reassembly of concatenated SMS
+
+  @details
+    The class collects the parts of concatenated messages read in PDU mode, keyed by originator and
+    reference number, and gives the complete messages to a handler; the storage slots of the parts
+    are freed afterwards with AT+CMGD.\n
+
+  @version
+    2.13.1
+
+  @note
+    Dependencies:
+    SMSAssembler.h
+
+  @author
+
+  @date
+    18/10/2026
+*/
+
+#include "SMSAssembler.h"
+
+using namespace me310;
+
+//! \brief Class Constructor
+/*!
+ * \param module     driver used to list and delete the messages
+ * \param handler    function receiving the reassembled messages
+ * \param context    pointer passed back to the handler
+ * \param timeout    max time in ms waiting for the missing parts of a message
+ */
+SMSAssembler::SMSAssembler(ME310 &module, handler_t handler, void *context, uint32_t timeout) :
+   _module(module), _handler(handler), _context(context), _timeout(timeout), _used(0), _deletes(0), _full(false),
+   _completed(0), _expired(0)
+{
+   memset(_entries, 0, sizeof(_entries));
+   for(int i = 0; i < SMS_ASSEMBLER_PARTS; i++)
+   {
+      _parts[i].entry = -1;
+   }
+}
+
+//! \brief Stores a part
+/*! \details
+Only SMS-DELIVER messages are stored. The handler is not called.
+ * \param index    storage index of the part, -1 if the part is not in the storage
+ * \param part     part decoded with SMSPDU::decode()
+ * \return false if the part has been refused, because it is not a received message or there is no room
+ */
+bool SMSAssembler::add(int index, const SMSPDU::message_t &part)
+{
+   if(part.type != SMSPDU::SMS_PDU_DELIVER)
+   {
+      return false;
+   }
+   uint8_t sequence = (part.concat.total > 1) ? part.concat.sequence : 1;
+   int entry = find(part);
+   if(entry >= 0)
+   {
+      for(int i = 0; i < SMS_ASSEMBLER_PARTS; i++)
+      {
+         if(_parts[i].entry == entry && _parts[i].sequence == sequence)
+         {
+            /* the same part stored twice, the copy is deleted with the message */
+            if(index >= 0 && index != _parts[i].index && _deletes < SMS_ASSEMBLER_DELETES - SMS_ASSEMBLER_PARTS)
+            {
+               _delete[_deletes++] = (int16_t)index;
+            }
+            return true;
+         }
+      }
+   }
+
+   int slot = -1;
+   for(int i = 0; i < SMS_ASSEMBLER_PARTS && slot < 0; i++)
+   {
+      if(_parts[i].entry < 0)
+      {
+         slot = i;
+      }
+   }
+   if(entry < 0)
+   {
+      for(int i = 0; i < SMS_ASSEMBLER_MESSAGES && entry < 0; i++)
+      {
+         if(!_entries[i].used)
+         {
+            entry = i;
+         }
+      }
+   }
+   if(slot < 0 || entry < 0 || part.len > SMS_ASSEMBLER_POOL_SIZE - _used)
+   {
+      _full = true;
+      return false;
+   }
+
+   entry_t &e = _entries[entry];
+   if(!e.used)
+   {
+      e.used = true;
+      snprintf(e.address, sizeof(e.address), "%s", part.address);
+      snprintf(e.timestamp, sizeof(e.timestamp), "%s", part.timestamp);
+      e.coding = part.coding;
+      e.reference = (part.concat.total > 1) ? part.concat.reference : 0;
+      e.total = (part.concat.total > 1) ? part.concat.total : 1;
+      e.received = 0;
+      e.first = millis();
+   }
+
+   /* the text of a message is contiguous and sorted by part number */
+   size_t offset = _used;
+   bool lower = false;
+   for(int i = 0; i < SMS_ASSEMBLER_PARTS; i++)
+   {
+      const part_t &p = _parts[i];
+      if(p.entry != entry)
+      {
+         continue;
+      }
+      if(p.sequence < sequence && (!lower || p.offset + p.len > offset))
+      {
+         offset = p.offset + p.len;
+         lower = true;
+      }
+      else if(p.sequence > sequence && !lower && p.offset < offset)
+      {
+         offset = p.offset;
+      }
+   }
+   memmove(_pool + offset + part.len, _pool + offset, _used - offset);
+   memcpy(_pool + offset, part.data, part.len);
+   for(int i = 0; i < SMS_ASSEMBLER_PARTS; i++)
+   {
+      if(_parts[i].entry >= 0 && _parts[i].offset >= offset)
+      {
+         _parts[i].offset += part.len;
+      }
+   }
+   _used += part.len;
+   part_t &p = _parts[slot];
+   p.entry = (int8_t)entry;
+   p.sequence = sequence;
+   p.index = (int16_t)index;
+   p.offset = (uint16_t)offset;
+   p.len = (uint16_t)part.len;
+   e.received++;
+   return true;
+}
+
+//! \brief Gives the complete and the expired messages to the handler
+/*! \details
+If a part has been refused since the last call, the oldest message is given as not complete to make room.
+Messages whose parts do not fit the deletion queue are kept for the next call, after flush().
+ * \param all    gives all the messages, complete or not
+ * \return number of messages given to the handler
+ */
+int SMSAssembler::dispatch(bool all)
+{
+   int count = 0;
+   uint32_t now = millis();
+   int oldest = -1;
+   for(int i = 0; i < SMS_ASSEMBLER_MESSAGES; i++)
+   {
+      entry_t &e = _entries[i];
+      if(!e.used)
+      {
+         continue;
+      }
+      if(e.received >= e.total || all || now - e.first >= _timeout)
+      {
+         count += emit(i, e.received >= e.total) ? 1 : 0;
+      }
+      else if(oldest < 0 || (int32_t)(e.first - _entries[oldest].first) < 0)
+      {
+         oldest = i;
+      }
+   }
+   if(_full && count == 0 && oldest >= 0)
+   {
+      count += emit(oldest, false) ? 1 : 0;
+   }
+   _full = false;
+   return count;
+}
+
+//! \brief Deletes the storage slots of the dispatched messages
+/*!
+ * \param aTimeout timeout in ms of each command
+ * \return return code of the first failed deletion, the remaining indexes are kept
+ */
+ME310::return_t SMSAssembler::flush(ME310::tout_t aTimeout)
+{
+   int done = 0;
+   ME310::return_t ret = ME310::RETURN_VALID;
+   for(; done < _deletes; done++)
+   {
+      ret = _module.delete_message(_delete[done], 0, aTimeout);
+      if(ret != ME310::RETURN_VALID)
+      {
+         break;
+      }
+   }
+   memmove(_delete, _delete + done, (_deletes - done) * sizeof(_delete[0]));
+   _deletes -= done;
+   return ret;
+}
+
+//! \brief Reads the new parts from the storage and dispatches the messages
+/*! \details
+The message format must be PDU. The storage is listed with AT+CMGL=4, the parts not held yet are decoded and
+added, then the messages are dispatched and their storage slots deleted. If parts have been refused, the
+cycle is repeated after making room.
+ * \param aTimeout timeout in ms of each command
+ * \return return code
+ */
+ME310::return_t SMSAssembler::poll(ME310::tout_t aTimeout)
+{
+   ME310::sms_message_t record;
+   SMSPDU::message_t part;
+   uint8_t text[SMS_PDU_TEXT_SIZE];
+   ME310::return_t ret = ME310::RETURN_VALID;
+   for(int round = 0; round <= SMS_ASSEMBLER_MESSAGES; round++)
+   {
+      _full = false;
+      ret = _module.sms_list_begin("4", aTimeout);
+      while(ret == ME310::RETURN_VALID)
+      {
+         ret = _module.sms_list_next(record, aTimeout);
+         if(ret == ME310::RETURN_DATA)
+         {
+            if(!held(record.index) && SMSPDU::decode(record.text, record.len, part, text, sizeof(text)))
+            {
+               add(record.index, part);
+            }
+            ret = ME310::RETURN_VALID;
+         }
+         else
+         {
+            break;
+         }
+      }
+      if(ret != ME310::RETURN_VALID)
+      {
+         return ret;
+      }
+      bool refused = _full;
+      dispatch();
+      ret = flush(aTimeout);
+      if(ret != ME310::RETURN_VALID || !refused)
+      {
+         break;
+      }
+   }
+   return ret;
+}
+
+//! \brief Returns the number of messages being reassembled
+/*!
+ * \return messages in the table
+ */
+int SMSAssembler::pending() const
+{
+   int count = 0;
+   for(int i = 0; i < SMS_ASSEMBLER_MESSAGES; i++)
+   {
+      count += _entries[i].used ? 1 : 0;
+   }
+   return count;
+}
+
+//! \brief Looks for the message a part belongs to
+/*!
+ * \param part    part
+ * \return entry of the message, -1 if not found or if the part is not concatenated
+ */
+int SMSAssembler::find(const SMSPDU::message_t &part) const
+{
+   if(part.concat.total <= 1)
+   {
+      return -1;
+   }
+   for(int i = 0; i < SMS_ASSEMBLER_MESSAGES; i++)
+   {
+      const entry_t &e = _entries[i];
+      if(e.used && e.reference == part.concat.reference && e.total == part.concat.total &&
+         strcmp(e.address, part.address) == 0)
+      {
+         return i;
+      }
+   }
+   return -1;
+}
+
+//! \brief Checks if a storage index is held
+/*!
+ * \param index    storage index
+ * \return true if a held part or a pending deletion has the index
+ */
+bool SMSAssembler::held(int index) const
+{
+   for(int i = 0; i < SMS_ASSEMBLER_PARTS; i++)
+   {
+      if(_parts[i].entry >= 0 && _parts[i].index == index)
+      {
+         return true;
+      }
+   }
+   for(int i = 0; i < _deletes; i++)
+   {
+      if(_delete[i] == index)
+      {
+         return true;
+      }
+   }
+   return false;
+}
+
+//! \brief Gives a message to the handler and frees its parts
+/*!
+ * \param entry       entry of the message
+ * \param complete    all the parts have been received
+ * \return false if the storage indexes of the parts do not fit the deletion queue
+ */
+bool SMSAssembler::emit(int entry, bool complete)
+{
+   entry_t &e = _entries[entry];
+   size_t start = _used;
+   size_t len = 0;
+   int indexes = 0;
+   for(int i = 0; i < SMS_ASSEMBLER_PARTS; i++)
+   {
+      if(_parts[i].entry == entry)
+      {
+         start = (_parts[i].offset < start) ? _parts[i].offset : start;
+         len += _parts[i].len;
+         indexes += (_parts[i].index >= 0) ? 1 : 0;
+      }
+   }
+   if(_deletes + indexes > SMS_ASSEMBLER_DELETES)
+   {
+      return false;
+   }
+
+   message_t message;
+   snprintf(message.address, sizeof(message.address), "%s", e.address);
+   snprintf(message.timestamp, sizeof(message.timestamp), "%s", e.timestamp);
+   message.coding = e.coding;
+   message.reference = e.reference;
+   message.total = e.total;
+   message.received = e.received;
+   message.complete = complete;
+   message.data = _pool + start;
+   message.len = len;
+   if(_handler != NULL)
+   {
+      _handler(message, _context);
+   }
+   if(complete)
+   {
+      _completed++;
+   }
+   else
+   {
+      _expired++;
+   }
+
+   memmove(_pool + start, _pool + start + len, _used - start - len);
+   _used -= len;
+   for(int i = 0; i < SMS_ASSEMBLER_PARTS; i++)
+   {
+      part_t &p = _parts[i];
+      if(p.entry == entry)
+      {
+         if(p.index >= 0)
+         {
+            _delete[_deletes++] = p.index;
+         }
+         p.entry = -1;
+      }
+      else if(p.entry >= 0 && p.offset > start)
+      {
+         p.offset -= len;
+      }
+   }
+   e.used = false;
+   return true;
+}
@@ -0,0 +1,141 @@
+/*Copyright (C) 2026 Telit Communications S.p.A. Italy - All Rights Reserved.*/
+/*    See LICENSE file in the project root for full license information.     */
+
+/**
+  @file
+    SMSAssembler.h
+
+  @brief
+    Reassembly of concatenated SMS
+
+  @details
+    The class collects the parts of concatenated messages read in PDU mode, keyed by originator and
+    reference number, and gives the complete messages to a handler; the storage slots of the parts
+    are freed afterwards with AT+CMGD.\n
+    Parts are kept in a fixed size pool, no memory is allocated.
+
+  @version
+    2.13.1
+
+  @note
+    Dependencies:
+    ME310.h
+    SMSPDU.h
+
+  @author
+
+  @date
+    18/10/2026
+*/
+#ifndef __SMSASSEMBLER__H
+#define __SMSASSEMBLER__H
+
+/* Include files ================================================================================*/
+#include "ME310.h"
+#include "SMSPDU.h"
+
+namespace me310
+{
+   #define SMS_ASSEMBLER_MESSAGES 4            ///< Max number of messages being reassembled
+   #define SMS_ASSEMBLER_PARTS 12              ///< Max number of parts held
+   #define SMS_ASSEMBLER_POOL_SIZE 1024        ///< Bytes of the pool holding the text of the parts
+   #define SMS_ASSEMBLER_DELETES (2 * SMS_ASSEMBLER_PARTS)   ///< Max number of storage indexes waiting for flush()
+   #define SMS_ASSEMBLER_TIMEOUT_MS 1800000UL  ///< Default max time waiting for the missing parts, 30 minutes
+
+   /*! \class SMSAssembler
+      \brief Reassembly buffer of concatenated SMS
+      \details
+      add() stores a part, in any order: the text of the parts of a message is kept contiguous in the pool
+      and sorted by part number, so a complete message is given to the handler without copies. Messages
+      that are not concatenated are stored as a message of one part. Parts already held are ignored.\n
+      dispatch() calls the handler for the complete messages and for the ones waiting longer than the
+      timeout, flagged as not complete. When add() finds the tables or the pool full, the part is refused
+      and left in the storage, and the next dispatch() gives the oldest message early as not complete. The
+      handler is never called by add(), so add() can be used while a listing is in progress.\n
+      The storage indexes of the dispatched parts are deleted by flush(). poll() lists the storage in PDU
+      mode and runs the whole cycle; parts that are still incomplete stay in the storage, so they are read
+      again after a reset.
+   */
+   class SMSAssembler
+   {
+      public:
+
+      /*! \struct message_t
+         \brief Reassembled message
+      */
+      typedef struct
+      {
+         char address[SMS_PDU_ADDRESS_SIZE];       ///< Originator address
+         char timestamp[SMS_PDU_TIMESTAMP_SIZE];   ///< Service centre time stamp of the first part received
+         SMSPDU::coding_t coding;                  ///< Data coding; the text of GSM 7 bit and UCS2 messages is UTF-8
+         uint16_t reference;                       ///< Reference number, 0 if the message is not concatenated
+         uint8_t total;                            ///< Number of parts
+         uint8_t received;                         ///< Parts received
+         bool complete;                            ///< All the parts have been received
+         const uint8_t *data;                      ///< Text or data of the parts received, in part order
+         size_t len;                               ///< Length of the data
+      } message_t;
+
+      typedef void (*handler_t)(const message_t &message, void *context);   //!< Receives the reassembled messages
+
+      SMSAssembler(ME310 &module, handler_t handler, void *context = NULL, uint32_t timeout = SMS_ASSEMBLER_TIMEOUT_MS);
+
+      bool add(int index, const SMSPDU::message_t &part);
+      int dispatch(bool all = false);
+      ME310::return_t flush(ME310::tout_t aTimeout = ME310::TOUT_1SEC);
+      ME310::return_t poll(ME310::tout_t aTimeout = ME310::TOUT_1SEC);
+
+      int pending() const;                                //!< Returns the number of messages being reassembled
+      uint32_t completed() const { return _completed; }   //!< Returns the complete messages dispatched
+      uint32_t expired() const { return _expired; }       //!< Returns the messages dispatched not complete
+
+      private:
+
+      /*! \struct entry_t
+         \brief Message being reassembled
+      */
+      typedef struct
+      {
+         bool used;                                ///< The entry holds a message
+         char address[SMS_PDU_ADDRESS_SIZE];       ///< Originator address
+         char timestamp[SMS_PDU_TIMESTAMP_SIZE];   ///< Time stamp of the first part received
+         SMSPDU::coding_t coding;                  ///< Data coding
+         uint16_t reference;                       ///< Reference number
+         uint8_t total;                            ///< Number of parts
+         uint8_t received;                         ///< Parts received
+         uint32_t first;                           ///< millis() of the first part received
+      } entry_t;
+
+      /*! \struct part_t
+         \brief Part held in the pool
+      */
+      typedef struct
+      {
+         int8_t entry;                             ///< Entry of the message, -1 if the slot is free
+         uint8_t sequence;                         ///< Part number
+         int16_t index;                            ///< Storage index, -1 if not known
+         uint16_t offset;                          ///< Offset of the text in the pool
+         uint16_t len;                             ///< Length of the text
+      } part_t;
+
+      int find(const SMSPDU::message_t &part) const;
+      bool held(int index) const;
+      bool emit(int entry, bool complete);
+
+      ME310 &_module;                                 //!< Driver used to list and delete the messages
+      handler_t _handler;                             //!< Handler of the reassembled messages
+      void *_context;                                 //!< Context passed to the handler
+      uint32_t _timeout;                              //!< Max time waiting for the missing parts, in ms
+      entry_t _entries[SMS_ASSEMBLER_MESSAGES];       //!< Messages being reassembled
+      part_t _parts[SMS_ASSEMBLER_PARTS];             //!< Parts held
+      uint8_t _pool[SMS_ASSEMBLER_POOL_SIZE];         //!< Text of the parts
+      size_t _used;                                   //!< Bytes used in the pool
+      int16_t _delete[SMS_ASSEMBLER_DELETES];         //!< Storage indexes to be deleted
+      int _deletes;                                   //!< Storage indexes in _delete
+      bool _full;                                     //!< A part has been refused since the last dispatch()
+      uint32_t _completed;                            //!< Complete messages dispatched
+      uint32_t _expired;                              //!< Messages dispatched not complete
+   };
+} // end namespace
+
+#endif //__SMSASSEMBLER__H
@@ -0,0 +1,795 @@
+/*Copyright (C) 2026 Telit Communications S.p.A. Italy - All Rights Reserved.*/
+/*    See LICENSE file in the project root for full license information.     */
+
+/**
+  @file
+    SMSPDU.cpp
+
+  @brief
+    Encoder and decoder of PDU mode SMS
+
+  @details
+    The class builds the SMS-SUBMIT PDUs sent with ME310::send_short_message(int, char*) when the message
+    format is PDU (AT+CMGF=0), and decodes the SMS-DELIVER and SMS-SUBMIT PDUs read with ME310::read_message()
+    or listed with ME310::sms_list_next().\n
+
+  @version
+    2.13.1
+
+  @note
+    Dependencies:
+    SMSPDU.h
+
+  @author
+
+  @date
+    18/10/2026
+*/
+
+#include "SMSPDU.h"
+
+using namespace me310;
+
+#define SMS_PDU_ESCAPE 0x1B          ///< GSM 7 bit escape to the extension table
+#define SMS_PDU_UDHI 0x40            ///< First octet flag of the user data header
+#define SMS_PDU_INTERNATIONAL 0x91   ///< Type of address of international numbers
+#define SMS_PDU_UNKNOWN 0x81         ///< Type of address of numbers of unknown type
+
+/* GSM 03.38 default alphabet, unicode code points */
+static const uint16_t GSM7_DEFAULT[128] =
+{
+   0x0040, 0x00A3, 0x0024, 0x00A5, 0x00E8, 0x00E9, 0x00F9, 0x00EC, 0x00F2, 0x00C7, 0x000A, 0x00D8, 0x00F8, 0x000D, 0x00C5, 0x00E5,
+   0x0394, 0x005F, 0x03A6, 0x0393, 0x039B, 0x03A9, 0x03A0, 0x03A8, 0x03A3, 0x0398, 0x039E, 0x00A0, 0x00C6, 0x00E6, 0x00DF, 0x00C9,
+   0x0020, 0x0021, 0x0022, 0x0023, 0x00A4, 0x0025, 0x0026, 0x0027, 0x0028, 0x0029, 0x002A, 0x002B, 0x002C, 0x002D, 0x002E, 0x002F,
+   0x0030, 0x0031, 0x0032, 0x0033, 0x0034, 0x0035, 0x0036, 0x0037, 0x0038, 0x0039, 0x003A, 0x003B, 0x003C, 0x003D, 0x003E, 0x003F,
+   0x00A1, 0x0041, 0x0042, 0x0043, 0x0044, 0x0045, 0x0046, 0x0047, 0x0048, 0x0049, 0x004A, 0x004B, 0x004C, 0x004D, 0x004E, 0x004F,
+   0x0050, 0x0051, 0x0052, 0x0053, 0x0054, 0x0055, 0x0056, 0x0057, 0x0058, 0x0059, 0x005A, 0x00C4, 0x00D6, 0x00D1, 0x00DC, 0x00A7,
+   0x00BF, 0x0061, 0x0062, 0x0063, 0x0064, 0x0065, 0x0066, 0x0067, 0x0068, 0x0069, 0x006A, 0x006B, 0x006C, 0x006D, 0x006E, 0x006F,
+   0x0070, 0x0071, 0x0072, 0x0073, 0x0074, 0x0075, 0x0076, 0x0077, 0x0078, 0x0079, 0x007A, 0x00E4, 0x00F6, 0x00F1, 0x00FC, 0x00E0
+};
+
+/* GSM 03.38 extension table, septet after the escape and unicode code point */
+static const uint16_t GSM7_EXTENSION[][2] =
+{
+   {0x0A, 0x000C}, {0x14, 0x005E}, {0x28, 0x007B}, {0x29, 0x007D}, {0x2F, 0x005C},
+   {0x3C, 0x005B}, {0x3D, 0x007E}, {0x3E, 0x005D}, {0x40, 0x007C}, {0x65, 0x20AC}
+};
+
+//! \brief Class Constructor
+/*!
+ * \param pdu     buffer receiving the PDU in hex, SMS_PDU_HEX_SIZE bytes fit any message
+ * \param size    size of the buffer
+ */
+SMSPDU::SMSPDU(char *pdu, size_t size) : _pdu(pdu), _size(size), _length(0)
+{
+   if(_size > 0)
+   {
+      _pdu[0] = 0;
+   }
+}
+
+//! \brief Builds a SMS-SUBMIT PDU
+/*! \details
+With SMS_PDU_GSM7 and SMS_PDU_UCS2 the data is UTF-8 text, converted to the coding; with SMS_PDU_8BIT it is sent
+as is. The user data must fit a single message, see segment_length(). No validity period is set and the
+message reference is assigned by the module.
+ * \param address    destination address, digits with an optional leading "+"
+ * \param data       text or data
+ * \param len        length of the data in bytes
+ * \param coding     data coding
+ * \param concat     part of a concatenated message, NULL if the message is not concatenated
+ * \param smsc       service centre address, NULL to use the one stored in the SIM
+ * \return TPDU length in bytes, -1 if the data does not fit or cannot be converted
+ */
+int SMSPDU::submit(const char *address, const uint8_t *data, size_t len, coding_t coding, const concat_t *concat, const char *smsc)
+{
+   uint8_t pdu[SMS_PDU_MAX_SIZE];
+   _length = 0;
+   if(_size > 0)
+   {
+      _pdu[0] = 0;
+   }
+   size_t n = put_address(pdu, smsc, true);
+   size_t tpdu = n;
+   size_t udhLen = concat_udh_size(concat);
+   bool udhi = (udhLen > 0);
+   pdu[n++] = 0x01 | (udhi ? SMS_PDU_UDHI : 0);   /* SMS-SUBMIT, no validity period */
+   pdu[n++] = 0x00;
+   size_t addressLen = put_address(pdu + n, address, false);
+   if(addressLen == 0)
+   {
+      return -1;
+   }
+   n += addressLen;
+   pdu[n++] = 0x00;
+   pdu[n++] = (uint8_t)coding;
+   size_t udl = n++;
+   uint8_t *ud = pdu + n;
+   memset(ud, 0, SMS_PDU_USER_DATA_SIZE);
+   size_t udh = 0;
+   if(udhi)
+   {
+      ud[udh++] = (uint8_t)(udhLen - 1);
+      if(udhLen == SMS_PDU_CONCAT16_UDH_SIZE)
+      {
+         ud[udh++] = 0x08;
+         ud[udh++] = 0x04;
+         ud[udh++] = (uint8_t)(concat->reference >> 8);
+      }
+      else
+      {
+         ud[udh++] = 0x00;
+         ud[udh++] = 0x03;
+      }
+      ud[udh++] = (uint8_t)concat->reference;
+      ud[udh++] = concat->total;
+      ud[udh++] = concat->sequence;
+   }
+
+   const char *text = (const char*)data;
+   const char *end = text + len;
+   if(coding == SMS_PDU_GSM7)
+   {
+      /* the text starts at the first septet boundary after the header */
+      size_t septet = (udh * 8 + 6) / 7;
+      while(text < end)
+      {
+         int code = gsm7_code(utf8_next(text, end));
+         if(code < 0 || septet + (code > 0x7F ? 2 : 1) > SMS_PDU_GSM7_SEPTETS)
+         {
+            return -1;
+         }
+         if(code > 0x7F)
+         {
+            put_septet(ud, septet++, SMS_PDU_ESCAPE);
+         }
+         put_septet(ud, septet++, (uint8_t)(code & 0x7F));
+      }
+      pdu[udl] = (uint8_t)septet;
+      n += (septet * 7 + 7) / 8;
+   }
+   else if(coding == SMS_PDU_UCS2)
+   {
+      size_t pos = udh;
+      while(text < end)
+      {
+         uint32_t code = utf8_next(text, end);
+         uint16_t units[2] = {(uint16_t)code, 0};
+         size_t count = 1;
+         if(code > 0xFFFF)
+         {
+            code -= 0x10000;
+            units[0] = (uint16_t)(0xD800 | (code >> 10));
+            units[1] = (uint16_t)(0xDC00 | (code & 0x3FF));
+            count = 2;
+         }
+         if(pos + 2 * count > SMS_PDU_USER_DATA_SIZE)
+         {
+            return -1;
+         }
+         for(size_t i = 0; i < count; i++)
+         {
+            ud[pos++] = (uint8_t)(units[i] >> 8);
+            ud[pos++] = (uint8_t)units[i];
+         }
+      }
+      pdu[udl] = (uint8_t)pos;
+      n += pos;
+   }
+   else
+   {
+      if(udh + len > SMS_PDU_USER_DATA_SIZE)
+      {
+         return -1;
+      }
+      memcpy(ud + udh, data, len);
+      pdu[udl] = (uint8_t)(udh + len);
+      n += udh + len;
+   }
+
+   if(2 * n + 1 > _size)
+   {
+      return -1;
+   }
+   static const char HEX[] = "0123456789ABCDEF";
+   for(size_t i = 0; i < n; i++)
+   {
+      _pdu[2 * i] = HEX[pdu[i] >> 4];
+      _pdu[2 * i + 1] = HEX[pdu[i] & 0x0F];
+   }
+   _pdu[2 * n] = 0;
+   _length = (int)(n - tpdu);
+   return _length;
+}
+
+//! \brief Builds a SMS-SUBMIT PDU with a text
+/*! \details
+The text is sent with the GSM 7 bit alphabet if all its characters are supported, otherwise with UCS2.
+ * \param address    destination address, digits with an optional leading "+"
+ * \param text       UTF-8 text
+ * \param concat     part of a concatenated message, NULL if the message is not concatenated
+ * \param smsc       service centre address, NULL to use the one stored in the SIM
+ * \return TPDU length in bytes, -1 if the text does not fit
+ */
+int SMSPDU::submit(const char *address, const char *text, const concat_t *concat, const char *smsc)
+{
+   coding_t coding = gsm7_compatible(text) ? SMS_PDU_GSM7 : SMS_PDU_UCS2;
+   return submit(address, (const uint8_t*)text, strlen(text), coding, concat, smsc);
+}
+
+//! \brief Decodes a PDU
+/*! \details
+The PDU must start with the service centre address, as reported by AT+CMGR and AT+CMGL. Texts are converted
+to UTF-8 and null terminated if the buffer has room for the terminator.
+ * \param hex        PDU in hex
+ * \param len        length of the hex string
+ * \param message    filled with the decoded message
+ * \param data       buffer receiving the text or the data, SMS_PDU_TEXT_SIZE bytes fit any message
+ * \param size       size of the buffer
+ * \return false if the PDU is not a valid SMS-DELIVER or SMS-SUBMIT, or the data does not fit the buffer
+ */
+bool SMSPDU::decode(const char *hex, size_t len, message_t &message, uint8_t *data, size_t size)
+{
+   uint8_t pdu[SMS_PDU_MAX_SIZE];
+   memset(&message, 0, sizeof(message));
+   message.data = data;
+   if(len % 2 != 0 || len / 2 > SMS_PDU_MAX_SIZE)
+   {
+      return false;
+   }
+   size_t n = len / 2;
+   for(size_t i = 0; i < len; i++)
+   {
+      char c = hex[i];
+      uint8_t nibble;
+      if(c >= '0' && c <= '9')
+      {
+         nibble = c - '0';
+      }
+      else if(c >= 'A' && c <= 'F')
+      {
+         nibble = c - 'A' + 10;
+      }
+      else if(c >= 'a' && c <= 'f')
+      {
+         nibble = c - 'a' + 10;
+      }
+      else
+      {
+         return false;
+      }
+      pdu[i / 2] = (i % 2 == 0) ? (uint8_t)(nibble << 4) : (uint8_t)(pdu[i / 2] | nibble);
+   }
+
+   size_t pos = get_address(pdu, n, message.smsc, true);
+   if(pos == 0 || pos >= n)
+   {
+      return false;
+   }
+   uint8_t first = pdu[pos++];
+   if((first & 0x03) == 0x00)
+   {
+      message.type = SMS_PDU_DELIVER;
+   }
+   else if((first & 0x03) == 0x01)
+   {
+      message.type = SMS_PDU_SUBMIT;
+      pos++;   /* message reference */
+   }
+   else
+   {
+      return false;
+   }
+   size_t addressLen = (pos < n) ? get_address(pdu + pos, n - pos, message.address, false) : 0;
+   if(addressLen == 0 || pos + addressLen + 2 > n)
+   {
+      return false;
+   }
+   pos += addressLen;
+   message.pid = pdu[pos++];
+   uint8_t dcs = pdu[pos++];
+   if(message.type == SMS_PDU_DELIVER)
+   {
+      if(pos + 7 > n)
+      {
+         return false;
+      }
+      /* semi-octets swapped, the time zone is in quarters of an hour with the sign in bit 3 */
+      const uint8_t *scts = pdu + pos;
+      int digits[6];
+      for(int i = 0; i < 6; i++)
+      {
+         digits[i] = (scts[i] & 0x0F) * 10 + (scts[i] >> 4);
+      }
+      int zone = (scts[6] & 0x07) * 10 + (scts[6] >> 4);
+      snprintf(message.timestamp, sizeof(message.timestamp), "%02d/%02d/%02d,%02d:%02d:%02d%c%02d",
+               digits[0], digits[1], digits[2], digits[3], digits[4], digits[5], (scts[6] & 0x08) ? '-' : '+', zone);
+      pos += 7;
+   }
+   else
+   {
+      uint8_t vpf = (first >> 3) & 0x03;
+      pos += (vpf == 0x02) ? 1 : ((vpf == 0x00) ? 0 : 7);
+   }
+   if(pos >= n)
+   {
+      return false;
+   }
+
+   /* data coding scheme: general data coding, automatic deletion and message classes groups */
+   if((dcs & 0x80) == 0x00)
+   {
+      if(dcs & 0x20)
+      {
+         return false;   /* compressed */
+      }
+      uint8_t alphabet = (dcs >> 2) & 0x03;
+      message.coding = (alphabet == 0) ? SMS_PDU_GSM7 : ((alphabet == 2) ? SMS_PDU_UCS2 : SMS_PDU_8BIT);
+   }
+   else if((dcs & 0xF0) == 0xF0)
+   {
+      message.coding = (dcs & 0x04) ? SMS_PDU_8BIT : SMS_PDU_GSM7;
+   }
+   else if((dcs & 0xF0) == 0xE0)
+   {
+      message.coding = SMS_PDU_UCS2;
+   }
+   else if((dcs & 0xE0) == 0xC0)
+   {
+      message.coding = SMS_PDU_GSM7;
+   }
+   else
+   {
+      message.coding = SMS_PDU_8BIT;
+   }
+
+   uint8_t udl = pdu[pos++];
+   const uint8_t *ud = pdu + pos;
+   size_t udLen = (message.coding == SMS_PDU_GSM7) ? (udl * 7 + 7) / 8 : udl;
+   if(pos + udLen > n)
+   {
+      return false;
+   }
+   size_t udh = 0;
+   if(first & SMS_PDU_UDHI)
+   {
+      udh = ud[0] + 1;
+      if(udh > udLen)
+      {
+         return false;
+      }
+      for(size_t i = 1; i + 1 < udh; )
+      {
+         uint8_t iei = ud[i];
+         uint8_t iedl = ud[i + 1];
+         const uint8_t *ie = ud + i + 2;
+         if(i + 2 + iedl > udh)
+         {
+            return false;
+         }
+         if(iei == 0x00 && iedl == 3)
+         {
+            message.concat.reference = ie[0];
+            message.concat.total = ie[1];
+            message.concat.sequence = ie[2];
+         }
+         else if(iei == 0x08 && iedl == 4)
+         {
+            message.concat.reference = (uint16_t)((ie[0] << 8) | ie[1]);
+            message.concat.total = ie[2];
+            message.concat.sequence = ie[3];
+         }
+         i += 2 + iedl;
+      }
+   }
+
+   size_t out = 0;
+   if(message.coding == SMS_PDU_GSM7)
+   {
+      size_t start = (udh * 8 + 6) / 7;
+      if(start > udl || !gsm7_to_utf8(ud, start, udl - start, data, size, out))
+      {
+         return false;
+      }
+   }
+   else if(message.coding == SMS_PDU_UCS2)
+   {
+      for(size_t i = udh; i + 1 < udl; i += 2)
+      {
+         uint32_t code = (ud[i] << 8) | ud[i + 1];
+         if(code >= 0xD800 && code < 0xDC00 && i + 3 < udl)
+         {
+            uint32_t low = (ud[i + 2] << 8) | ud[i + 3];
+            if(low >= 0xDC00 && low < 0xE000)
+            {
+               code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+               i += 2;
+            }
+         }
+         size_t next = utf8_put(code, data, out, size);
+         if(next == 0)
+         {
+            return false;
+         }
+         out = next;
+      }
+   }
+   else
+   {
+      if(udl - udh > size)
+      {
+         return false;
+      }
+      memcpy(data, ud + udh, udl - udh);
+      out = udl - udh;
+   }
+   if(out < size)
+   {
+      data[out] = 0;
+   }
+   message.len = out;
+   return true;
+}
+
+//! \brief Checks if a text can be sent with the GSM 7 bit alphabet
+/*!
+ * \param text    UTF-8 text
+ * \return true if all the characters are in the default alphabet or in the extension table
+ */
+bool SMSPDU::gsm7_compatible(const char *text)
+{
+   const char *end = text + strlen(text);
+   while(text < end)
+   {
+      if(gsm7_code(utf8_next(text, end)) < 0)
+      {
+         return false;
+      }
+   }
+   return true;
+}
+
+//! \brief Returns the length of the part of a text that fits a message
+/*! \details
+Characters are never split: UTF-8 sequences, extension table escapes and UCS2 surrogate pairs are kept whole.
+ * \param text      UTF-8 text, or data with SMS_PDU_8BIT
+ * \param coding    data coding
+ * \param concat    part the text is sent with, NULL if the message is not concatenated; only the reference
+ *                  is used, to size the header
+ * \return length in bytes of the text that fits, the whole text if it fits a single message
+ */
+size_t SMSPDU::segment_length(const char *text, coding_t coding, const concat_t *concat)
+{
+   size_t udh = (concat != NULL) ? (concat->reference > 0xFF ? SMS_PDU_CONCAT16_UDH_SIZE : SMS_PDU_CONCAT_UDH_SIZE) : 0;
+   size_t len = strlen(text);
+   if(coding == SMS_PDU_8BIT)
+   {
+      size_t room = SMS_PDU_USER_DATA_SIZE - udh;
+      return (len < room) ? len : room;
+   }
+   size_t room = (coding == SMS_PDU_GSM7) ? SMS_PDU_GSM7_SEPTETS - (udh * 8 + 6) / 7 : SMS_PDU_USER_DATA_SIZE - udh;
+   const char *p = text;
+   const char *end = text + len;
+   size_t used = 0;
+   while(p < end)
+   {
+      const char *next = p;
+      uint32_t code = utf8_next(next, end);
+      size_t cost;
+      if(coding == SMS_PDU_GSM7)
+      {
+         cost = (gsm7_code(code) > 0x7F) ? 2 : 1;
+      }
+      else
+      {
+         cost = (code > 0xFFFF) ? 4 : 2;
+      }
+      if(used + cost > room)
+      {
+         break;
+      }
+      used += cost;
+      p = next;
+   }
+   return p - text;
+}
+
+//! \brief Returns the size of the concatenation header of a part
+/*!
+ * \param concat    part, may be NULL
+ * \return header size in bytes, 0 if the message is not concatenated
+ */
+size_t SMSPDU::concat_udh_size(const concat_t *concat)
+{
+   if(concat == NULL || concat->total == 0)
+   {
+      return 0;
+   }
+   return (concat->reference > 0xFF) ? SMS_PDU_CONCAT16_UDH_SIZE : SMS_PDU_CONCAT_UDH_SIZE;
+}
+
+//! \brief Reads a character from a UTF-8 text
+/*!
+ * \param text    text, moved to the next character
+ * \param end     end of the text
+ * \return unicode code point, U+FFFD for invalid sequences
+ */
+uint32_t SMSPDU::utf8_next(const char *&text, const char *end)
+{
+   uint8_t c = (uint8_t)*text++;
+   if(c < 0x80)
+   {
+      return c;
+   }
+   int count;
+   uint32_t code;
+   if((c & 0xE0) == 0xC0)
+   {
+      count = 1;
+      code = c & 0x1F;
+   }
+   else if((c & 0xF0) == 0xE0)
+   {
+      count = 2;
+      code = c & 0x0F;
+   }
+   else if((c & 0xF8) == 0xF0)
+   {
+      count = 3;
+      code = c & 0x07;
+   }
+   else
+   {
+      return 0xFFFD;
+   }
+   for(int i = 0; i < count; i++)
+   {
+      if(text >= end || ((uint8_t)*text & 0xC0) != 0x80)
+      {
+         return 0xFFFD;
+      }
+      code = (code << 6) | ((uint8_t)*text++ & 0x3F);
+   }
+   return code;
+}
+
+//! \brief Writes a character as UTF-8
+/*!
+ * \param code    unicode code point
+ * \param data    buffer
+ * \param pos     position in the buffer
+ * \param size    size of the buffer
+ * \return position after the character, 0 if the buffer has no room
+ */
+size_t SMSPDU::utf8_put(uint32_t code, uint8_t *data, size_t pos, size_t size)
+{
+   size_t count = (code < 0x80) ? 1 : ((code < 0x800) ? 2 : ((code < 0x10000) ? 3 : 4));
+   if(pos + count > size)
+   {
+      return 0;
+   }
+   if(count == 1)
+   {
+      data[pos] = (uint8_t)code;
+      return pos + 1;
+   }
+   static const uint8_t LEAD[] = {0, 0, 0xC0, 0xE0, 0xF0};
+   for(size_t i = count - 1; i > 0; i--)
+   {
+      data[pos + i] = (uint8_t)(0x80 | (code & 0x3F));
+      code >>= 6;
+   }
+   data[pos] = (uint8_t)(LEAD[count] | code);
+   return pos + count;
+}
+
+//! \brief Returns the GSM 7 bit code of a character
+/*!
+ * \param code    unicode code point
+ * \return septet of the default alphabet, 0x100 plus the septet for the extension table, -1 if not supported
+ */
+int SMSPDU::gsm7_code(uint32_t code)
+{
+   for(int i = 0; i < 128; i++)
+   {
+      if(GSM7_DEFAULT[i] == code && i != SMS_PDU_ESCAPE)
+      {
+         return i;
+      }
+   }
+   for(size_t i = 0; i < sizeof(GSM7_EXTENSION) / sizeof(GSM7_EXTENSION[0]); i++)
+   {
+      if(GSM7_EXTENSION[i][1] == code)
+      {
+         return 0x100 | GSM7_EXTENSION[i][0];
+      }
+   }
+   return -1;
+}
+
+//! \brief Converts GSM 7 bit packed septets to UTF-8
+/*! \details
+An escape followed by a septet missing from the extension table gives the character of the default alphabet.
+ * \param ud       packed septets
+ * \param first    index of the first septet
+ * \param count    number of septets
+ * \param data     buffer receiving the text
+ * \param size     size of the buffer
+ * \param len      receives the length of the text
+ * \return false if the buffer has no room for the text
+ */
+bool SMSPDU::gsm7_to_utf8(const uint8_t *ud, size_t first, size_t count, uint8_t *data, size_t size, size_t &len)
+{
+   len = 0;
+   bool escape = false;
+   for(size_t i = first; i < first + count; i++)
+   {
+      uint8_t septet = get_septet(ud, i);
+      if(septet == SMS_PDU_ESCAPE && !escape)
+      {
+         escape = true;
+         continue;
+      }
+      uint32_t code = GSM7_DEFAULT[septet];
+      if(escape)
+      {
+         for(size_t j = 0; j < sizeof(GSM7_EXTENSION) / sizeof(GSM7_EXTENSION[0]); j++)
+         {
+            if(GSM7_EXTENSION[j][0] == septet)
+            {
+               code = GSM7_EXTENSION[j][1];
+            }
+         }
+         escape = false;
+      }
+      size_t next = utf8_put(code, data, len, size);
+      if(next == 0)
+      {
+         return false;
+      }
+      len = next;
+   }
+   return true;
+}
+
+//! \brief Writes a septet in a packed buffer
+/*!
+ * \param ud       packed septets, cleared before the first septet
+ * \param index    septet index
+ * \param value    septet
+ */
+void SMSPDU::put_septet(uint8_t *ud, size_t index, uint8_t value)
+{
+   size_t bit = index * 7;
+   ud[bit / 8] |= (uint8_t)(value << (bit % 8));
+   if(bit % 8 > 1)
+   {
+      ud[bit / 8 + 1] |= (uint8_t)(value >> (8 - bit % 8));
+   }
+}
+
+//! \brief Reads a septet from a packed buffer
+/*!
+ * \param ud       packed septets
+ * \param index    septet index
+ * \return septet
+ */
+uint8_t SMSPDU::get_septet(const uint8_t *ud, size_t index)
+{
+   size_t bit = index * 7;
+   unsigned value = ud[bit / 8] >> (bit % 8);
+   if(bit % 8 > 1)
+   {
+      value |= ud[bit / 8 + 1] << (8 - bit % 8);
+   }
+   return (uint8_t)(value & 0x7F);
+}
+
+//! \brief Writes an address as swapped semi-octets
+/*!
+ * \param pdu        buffer, at least 12 bytes
+ * \param address    digits, "*" and "#", with an optional leading "+"
+ * \param smsc       service centre address, whose length is in octets and may be empty
+ * \return bytes written, 0 if the address is not valid
+ */
+size_t SMSPDU::put_address(uint8_t *pdu, const char *address, bool smsc)
+{
+   if(address == NULL || *address == 0)
+   {
+      pdu[0] = 0;
+      return smsc ? 1 : 0;
+   }
+   uint8_t type = SMS_PDU_UNKNOWN;
+   if(*address == '+')
+   {
+      type = SMS_PDU_INTERNATIONAL;
+      address++;
+   }
+   size_t digits = strlen(address);
+   if(digits == 0 || digits > SMS_PDU_ADDRESS_SIZE - 2)
+   {
+      return 0;
+   }
+   size_t octets = (digits + 1) / 2;
+   pdu[0] = (uint8_t)(smsc ? octets + 1 : digits);
+   pdu[1] = type;
+   memset(pdu + 2, 0xFF, octets);
+   for(size_t i = 0; i < digits; i++)
+   {
+      char c = address[i];
+      uint8_t nibble;
+      if(c >= '0' && c <= '9')
+      {
+         nibble = c - '0';
+      }
+      else if(c == '*')
+      {
+         nibble = 0x0A;
+      }
+      else if(c == '#')
+      {
+         nibble = 0x0B;
+      }
+      else
+      {
+         return 0;
+      }
+      uint8_t &octet = pdu[2 + i / 2];
+      octet = (i % 2 == 0) ? (uint8_t)((octet & 0xF0) | nibble) : (uint8_t)((octet & 0x0F) | (nibble << 4));
+   }
+   return 2 + octets;
+}
+
+//! \brief Reads an address
+/*!
+ * \param pdu        address field
+ * \param len        bytes available
+ * \param address    receives the address, SMS_PDU_ADDRESS_SIZE bytes
+ * \param smsc       service centre address, whose length is in octets and may be empty
+ * \return bytes read, 0 if the field is truncated
+ */
+size_t SMSPDU::get_address(const uint8_t *pdu, size_t len, char *address, bool smsc)
+{
+   address[0] = 0;
+   if(len < 1)
+   {
+      return 0;
+   }
+   if(pdu[0] == 0)
+   {
+      return (smsc ? 1 : ((len >= 2) ? 2 : 0));
+   }
+   size_t octets = smsc ? pdu[0] - 1 : (pdu[0] + 1) / 2;
+   if(2 + octets > len || (smsc && pdu[0] < 1))
+   {
+      return 0;
+   }
+   uint8_t type = pdu[1];
+   const uint8_t *value = pdu + 2;
+   size_t pos = 0;
+   if((type & 0x70) == 0x50)
+   {
+      /* alphanumeric, GSM 7 bit packed */
+      size_t count = smsc ? octets * 8 / 7 : pdu[0] * 4 / 7;
+      size_t textLen = 0;
+      gsm7_to_utf8(value, 0, count, (uint8_t*)address, SMS_PDU_ADDRESS_SIZE - 1, textLen);
+      address[textLen] = 0;
+      return 2 + octets;
+   }
+   if((type & 0x70) == 0x10)
+   {
+      address[pos++] = '+';
+   }
+   static const char DIGITS[] = "0123456789*#abc";
+   for(size_t i = 0; i < 2 * octets && pos < SMS_PDU_ADDRESS_SIZE - 1; i++)
+   {
+      uint8_t nibble = (i % 2 == 0) ? (value[i / 2] & 0x0F) : (value[i / 2] >> 4);
+      if(nibble == 0x0F)
+      {
+         break;
+      }
+      address[pos++] = DIGITS[nibble];
+   }
+   address[pos] = 0;
+   return 2 + octets;
+}
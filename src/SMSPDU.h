@@ -0,0 +1,135 @@
+/*Copyright (C) 2026 Telit Communications S.p.A. Italy - All Rights Reserved.*/
+/*    See LICENSE file in the project root for full license information.     */
+
+/**
+  @file
+    SMSPDU.h
+
+  @brief
+    Encoder and decoder of PDU mode SMS
+
+  @details
+    The class builds the SMS-SUBMIT PDUs sent with ME310::send_short_message(int, char*) when the message
+    format is PDU (AT+CMGF=0), and decodes the SMS-DELIVER and SMS-SUBMIT PDUs read with ME310::read_message()
+    or listed with ME310::sms_list_next().\n
+    Supported data codings are the GSM 7 bit default alphabet with its extension table, 8 bit data and UCS2;
+    text is exchanged with the application as UTF-8. Concatenated messages carry a user data header with
+    8 bit reference numbers, or 16 bit ones when the reference is greater than 255.
+
+  @version
+    2.13.1
+
+  @note
+    Dependencies:
+    ME310.h
+
+  @author
+
+  @date
+    18/10/2026
+*/
+#ifndef __SMSPDU__H
+#define __SMSPDU__H
+
+/* Include files ================================================================================*/
+#include "ME310.h"
+
+namespace me310
+{
+   #define SMS_PDU_ADDRESS_SIZE 22       ///< Max length of an address, "+" and 20 digits, including terminator
+   #define SMS_PDU_TIMESTAMP_SIZE 21     ///< Length of a time stamp "yy/MM/dd,hh:mm:ss+zz", including terminator
+   #define SMS_PDU_MAX_SIZE 176          ///< Max PDU size in bytes, service centre address included
+   #define SMS_PDU_HEX_SIZE (2 * SMS_PDU_MAX_SIZE + 1)   ///< Size of a buffer holding a PDU in hex, including terminator
+   #define SMS_PDU_USER_DATA_SIZE 140    ///< Max user data size in bytes
+   #define SMS_PDU_GSM7_SEPTETS 160      ///< Max GSM 7 bit characters of a single message
+   #define SMS_PDU_CONCAT_UDH_SIZE 6     ///< Size of the user data header of a concatenated message, 8 bit reference
+   #define SMS_PDU_CONCAT16_UDH_SIZE 7   ///< Size of the user data header of a concatenated message, 16 bit reference
+   #define SMS_PDU_TEXT_SIZE (3 * SMS_PDU_GSM7_SEPTETS + 1)   ///< Size of a buffer holding any decoded text as UTF-8, including terminator
+
+   /*! \class SMSPDU
+      \brief Encoder and decoder of PDU mode SMS
+      \details
+      submit() writes the PDU in hex in the buffer given to the constructor and returns the TPDU length, which
+      is the length argument of AT+CMGS:\n
+      module.message_format(0);\n
+      SMSPDU pdu(buffer, sizeof(buffer));\n
+      if(pdu.submit("+393331234567", "t=21.5") > 0) module.send_short_message(pdu.length(), pdu.pdu());\n
+      Texts longer than a message are split with segment_length() and sent with a concat_t on each part; the
+      header takes one more byte when the reference is greater than 255.
+      decode() is static and fills a message_t, whose data points into a buffer given by the application:
+      text is converted to UTF-8, 8 bit data is copied as is.
+   */
+   class SMSPDU
+   {
+      public:
+
+      typedef enum
+      {
+         SMS_PDU_GSM7 = 0x00,    ///< GSM 7 bit default alphabet
+         SMS_PDU_8BIT = 0x04,    ///< 8 bit data
+         SMS_PDU_UCS2 = 0x08     ///< UCS2, big endian
+      } coding_t;
+
+      typedef enum
+      {
+         SMS_PDU_DELIVER = 0,    ///< Received message
+         SMS_PDU_SUBMIT = 1      ///< Message to be sent, as stored in the SIM
+      } type_t;
+
+      /*! \struct concat_t
+         \brief Part of a concatenated message
+      */
+      typedef struct
+      {
+         uint16_t reference;     ///< Reference number, the same for all the parts; sent with 16 bits if greater than 255
+         uint8_t total;          ///< Number of parts, 0 if the message is not concatenated
+         uint8_t sequence;       ///< Part number, starting from 1
+      } concat_t;
+
+      /*! \struct message_t
+         \brief Decoded PDU
+      */
+      typedef struct
+      {
+         type_t type;                              ///< SMS-DELIVER or SMS-SUBMIT
+         char smsc[SMS_PDU_ADDRESS_SIZE];          ///< Service centre address, empty if not reported
+         char address[SMS_PDU_ADDRESS_SIZE];       ///< Originator (SMS-DELIVER) or destination (SMS-SUBMIT) address
+         char timestamp[SMS_PDU_TIMESTAMP_SIZE];   ///< Service centre time stamp, empty for SMS-SUBMIT
+         uint8_t pid;                              ///< Protocol identifier
+         coding_t coding;                          ///< Data coding of the user data
+         concat_t concat;                          ///< Concatenation information
+         const uint8_t *data;                      ///< UTF-8 text, or 8 bit data, in the buffer given to decode()
+         size_t len;                               ///< Length of the data
+      } message_t;
+
+      SMSPDU(char *pdu, size_t size);
+
+      int submit(const char *address, const uint8_t *data, size_t len, coding_t coding, const concat_t *concat = NULL, const char *smsc = NULL);
+      int submit(const char *address, const char *text, const concat_t *concat = NULL, const char *smsc = NULL);
+
+      char *pdu() { return _pdu; }                 //!< Returns the PDU in hex
+      int length() const { return _length; }       //!< Returns the TPDU length in bytes, the argument of AT+CMGS
+
+      static bool decode(const char *hex, size_t len, message_t &message, uint8_t *data, size_t size);
+      static bool gsm7_compatible(const char *text);
+      static size_t segment_length(const char *text, coding_t coding, const concat_t *concat = NULL);
+
+      private:
+
+      static size_t concat_udh_size(const concat_t *concat);
+      static uint32_t utf8_next(const char *&text, const char *end);
+      static size_t utf8_put(uint32_t code, uint8_t *data, size_t pos, size_t size);
+      static int gsm7_code(uint32_t code);
+      static bool gsm7_to_utf8(const uint8_t *ud, size_t first, size_t count, uint8_t *data, size_t size, size_t &len);
+      static void put_septet(uint8_t *ud, size_t index, uint8_t value);
+      static uint8_t get_septet(const uint8_t *ud, size_t index);
+      static size_t put_address(uint8_t *pdu, const char *address, bool smsc);
+      static size_t get_address(const uint8_t *pdu, size_t len, char *address, bool smsc);
+
+      char *_pdu;                //!< Buffer of the PDU in hex
+      size_t _size;              //!< Size of the buffer
+      int _length;               //!< TPDU length of the last PDU built
+   };
+} // end namespace
+
+#endif //__SMSPDU__H
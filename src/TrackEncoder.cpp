@@ -0,0 +1,270 @@
+/*Copyright (C) 2026 Telit Communications S.p.A. Italy - All Rights Reserved.*/
+/*    See LICENSE file in the project root for full license information.     */
+
+/**
+  @file
+    TrackEncoder.cpp
+
+  @brief
+    Compact binary encoding of GNSS tracks
+
+  @details
+    The class thins a stream of fixes with a dead band around the position predicted from the last
+    kept points, and encodes the kept points as zigzag varint deltas in a binary frame.\n
+
+  @version
+    2.13.1
+
+  @note
+    Dependencies:
+    TrackEncoder.h
+
+  @author
+
+  @date
+    18/10/2026
+*/
+
+#include "TrackEncoder.h"
+#include <math.h>
+
+using namespace me310;
+
+#define TRACK_CM_PER_UNIT 1.113195f   ///< Length in cm of 1e-7 degrees of latitude
+
+//! \brief Class Constructor
+/*!
+ * \param frame        buffer of the frame, at least TRACK_HEADER_SIZE + 3 * TRACK_POINT_MAX_SIZE bytes
+ * \param size         size of the buffer
+ * \param tolerance    dead band in cm
+ * \param maxGap       max time in seconds between kept points, 0 keeps every fix
+ * \param precision    decimal digits removed from the 1e-7 degrees coordinates, up to 4; 1 gives about 11 cm
+ */
+TrackEncoder::TrackEncoder(uint8_t *frame, size_t size, uint32_t tolerance, uint32_t maxGap, uint8_t precision) :
+   _frame(frame), _size(size), _len(0), _tolerance(tolerance), _maxGap(maxGap), _precision(precision > 4 ? 4 : precision),
+   _divisor(1), _points(0), _hasCandidate(false), _encLatitude(0), _encLongitude(0), _encTime(0),
+   _fixes(0), _kept(0), _bytes(0)
+{
+   for(int i = 0; i < _precision; i++)
+   {
+      _divisor *= 10;
+   }
+   reset();
+   _bytes = 0;
+}
+
+//! \brief Adds a fix
+/*!
+ * \param latitude     latitude in 1e-7 degrees
+ * \param longitude    longitude in 1e-7 degrees
+ * \param time         time in seconds, e.g. from unix_time()
+ * \return TRACK_KEPT if one or two points have been written, TRACK_FULL if the frame must be sent first
+ */
+TrackEncoder::result_t TrackEncoder::add(int32_t latitude, int32_t longitude, uint32_t time)
+{
+   if(full())
+   {
+      return TRACK_FULL;
+   }
+   _fixes++;
+   point_t point = {latitude, longitude, time};
+   if(_points > 0 && !outside(point))
+   {
+      _candidate = point;
+      _hasCandidate = true;
+      return TRACK_DROPPED;
+   }
+   if(_hasCandidate)
+   {
+      /* the last fix inside the dead band ends the segment */
+      keep(_candidate);
+      _hasCandidate = false;
+      if(!outside(point))
+      {
+         _candidate = point;
+         _hasCandidate = true;
+         return TRACK_KEPT;
+      }
+   }
+   keep(point);
+   return TRACK_KEPT;
+}
+
+//! \brief Adds a fix read with AT$GPSACP
+/*!
+ * \param fix    position, ignored if not valid
+ * \return TRACK_DROPPED for invalid fixes, otherwise as add(int32_t, int32_t, uint32_t)
+ */
+TrackEncoder::result_t TrackEncoder::add(const ME310::gnss_fix_t &fix)
+{
+   if(!fix.valid)
+   {
+      return full() ? TRACK_FULL : TRACK_DROPPED;
+   }
+   return add(fix.latitude, fix.longitude, unix_time(fix));
+}
+
+//! \brief Writes the last dropped fix, so that the frame ends at the last position
+/*!
+ * \return frame length in bytes
+ */
+size_t TrackEncoder::finish()
+{
+   if(_hasCandidate)
+   {
+      keep(_candidate);
+      _hasCandidate = false;
+   }
+   return _len;
+}
+
+//! \brief Starts a new frame
+/*! \details
+The first point of the new frame is written as absolute; the dead band keeps using the last kept points.
+ */
+void TrackEncoder::reset()
+{
+   _bytes += _len;
+   _len = 0;
+   if(_size >= TRACK_HEADER_SIZE)
+   {
+      _frame[_len++] = TRACK_FRAME_VERSION;
+      _frame[_len++] = _precision;
+      _frame[_len++] = 0;
+   }
+}
+
+//! \brief Starts a new frame and a new track
+/*! \details
+To be called after a long loss of fix: the next fix is kept and not compared with the previous track.
+ */
+void TrackEncoder::restart()
+{
+   reset();
+   _points = 0;
+   _hasCandidate = false;
+}
+
+//! \brief Checks if the frame must be sent
+/*!
+ * \return true if the frame has no room for the points add() and finish() can write
+ */
+bool TrackEncoder::full() const
+{
+   return _len < TRACK_HEADER_SIZE || _len + 3 * TRACK_POINT_MAX_SIZE > _size || _frame[2] > TRACK_MAX_POINTS - 3;
+}
+
+//! \brief Converts the UTC time of a fix to seconds since 1970
+/*!
+ * \param fix    position
+ * \return seconds since 1970-01-01, seconds of the day if the date is not known
+ */
+uint32_t TrackEncoder::unix_time(const ME310::gnss_fix_t &fix)
+{
+   uint32_t seconds = fix.hour * 3600UL + fix.minute * 60UL + fix.second;
+   if(fix.year == 0 || fix.month == 0 || fix.day == 0)
+   {
+      return seconds;
+   }
+   /* days from civil date, years starting in March */
+   int32_t y = fix.year - (fix.month <= 2 ? 1 : 0);
+   int32_t era = y / 400;
+   int32_t yoe = y - era * 400;
+   int32_t doy = (153 * (fix.month + (fix.month > 2 ? -3 : 9)) + 2) / 5 + fix.day - 1;
+   int32_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+   int32_t days = era * 146097 + doe - 719468;
+   return (uint32_t)days * 86400UL + seconds;
+}
+
+//! \brief Checks if a fix is outside the dead band
+/*!
+ * \param point    fix
+ * \return true if the fix must be kept
+ */
+bool TrackEncoder::outside(const point_t &point) const
+{
+   int32_t elapsed = (int32_t)(point.time - _last.time);
+   if(_points == 0 || elapsed < 0 || (uint32_t)elapsed >= _maxGap)
+   {
+      return true;
+   }
+   float latitude = _last.latitude;
+   float longitude = _last.longitude;
+   int32_t step = (int32_t)(_last.time - _prev.time);
+   if(_points > 1 && step > 0)
+   {
+      /* linear extrapolation of the last two kept points */
+      float k = (float)elapsed / step;
+      latitude += k * (float)(_last.latitude - _prev.latitude);
+      longitude += k * (float)(_last.longitude - _prev.longitude);
+   }
+   float scale = cos(point.latitude * (float)(M_PI / 180.0 / 1e7));
+   float dy = (point.latitude - latitude) * TRACK_CM_PER_UNIT;
+   float dx = (point.longitude - longitude) * TRACK_CM_PER_UNIT * scale;
+   return dx * dx + dy * dy > (float)_tolerance * _tolerance;
+}
+
+//! \brief Writes a point in the frame
+/*!
+ * \param point    point to write
+ */
+void TrackEncoder::keep(const point_t &point)
+{
+   int32_t latitude = quantize(point.latitude);
+   int32_t longitude = quantize(point.longitude);
+   if(_frame[2] == 0)
+   {
+      write(((uint32_t)latitude << 1) ^ (uint32_t)(latitude >> 31));
+      write(((uint32_t)longitude << 1) ^ (uint32_t)(longitude >> 31));
+      write(point.time);
+   }
+   else
+   {
+      /* deltas wrap around 32 bits, the decoder does the same */
+      int32_t dlat = (int32_t)((uint32_t)latitude - (uint32_t)_encLatitude);
+      int32_t dlon = (int32_t)((uint32_t)longitude - (uint32_t)_encLongitude);
+      int32_t dtime = (int32_t)(point.time - _encTime);
+      write(((uint32_t)dlat << 1) ^ (uint32_t)(dlat >> 31));
+      write(((uint32_t)dlon << 1) ^ (uint32_t)(dlon >> 31));
+      write(((uint32_t)dtime << 1) ^ (uint32_t)(dtime >> 31));
+   }
+   _frame[2]++;
+   _encLatitude = latitude;
+   _encLongitude = longitude;
+   _encTime = point.time;
+   _kept++;
+   _prev = _last;
+   _last = point;
+   if(_points < 2)
+   {
+      _points++;
+   }
+}
+
+//! \brief Writes an unsigned varint, 7 bits per byte, least significant first
+/*!
+ * \param value    value to write
+ */
+void TrackEncoder::write(uint32_t value)
+{
+   while(value >= 0x80)
+   {
+      _frame[_len++] = (uint8_t)(value | 0x80);
+      value >>= 7;
+   }
+   _frame[_len++] = (uint8_t)value;
+}
+
+//! \brief Removes the precision digits from a coordinate, with rounding
+/*!
+ * \param value    coordinate in 1e-7 degrees
+ * \return coordinate in 10^(precision-7) degrees
+ */
+int32_t TrackEncoder::quantize(int32_t value) const
+{
+   if(value >= 0)
+   {
+      return (value + _divisor / 2) / _divisor;
+   }
+   return -((-value + _divisor / 2) / _divisor);
+}
@@ -0,0 +1,122 @@
+/*Copyright (C) 2026 Telit Communications S.p.A. Italy - All Rights Reserved.*/
+/*    See LICENSE file in the project root for full license information.     */
+
+/**
+  @file
+    TrackEncoder.h
+
+  @brief
+    Compact binary encoding of GNSS tracks
+
+  @details
+    The class thins a stream of fixes with a dead band around the position predicted from the last
+    kept points, and encodes the kept points as zigzag varint deltas in a binary frame, to be sent
+    over MQTT or sockets and decoded with extras/track_decoder/track_decoder.py.\n
+    The frame is written in a buffer given by the application, no memory is allocated.
+
+  @version
+    2.13.1
+
+  @note
+    Dependencies:
+    ME310.h
+
+  @author
+
+  @date
+    18/10/2026
+*/
+#ifndef __TRACKENCODER__H
+#define __TRACKENCODER__H
+
+/* Include files ================================================================================*/
+#include "ME310.h"
+
+namespace me310
+{
+   #define TRACK_FRAME_VERSION 1        ///< First byte of the frames
+   #define TRACK_HEADER_SIZE 3          ///< Version, precision and number of points
+   #define TRACK_POINT_MAX_SIZE 15      ///< Max encoded size of a point, three 5 bytes varints
+   #define TRACK_MAX_POINTS 255         ///< Max number of points of a frame
+
+   /*! \class TrackEncoder
+      \brief Dead band thinning and delta encoding of fixes
+      \details
+      A fix is dropped when it is within the tolerance of the position extrapolated from the last two kept
+      points and less than maxGap seconds after the last kept point. When a fix falls outside, the last dropped
+      fix is kept first, so that the track rebuilt by linear interpolation between the kept points stays close
+      to the dropped ones.\n
+      Frame layout: version, precision (decimal digits removed from the 1e-7 degrees coordinates), number of
+      points, then for each point latitude, longitude and time as varints. The first point is absolute, the
+      others are deltas from the previous point; coordinates are zigzag encoded. Times are in seconds.\n
+      When full() returns true, the application calls finish(), sends frame() and starts a new frame with
+      reset(); the thinning state is kept across frames.
+   */
+   class TrackEncoder
+   {
+      public:
+
+      typedef enum
+      {
+         TRACK_DROPPED = 0,   ///< Fix within the dead band, not written
+         TRACK_KEPT,          ///< Fix written in the frame
+         TRACK_FULL           ///< Frame full, the fix has not been processed
+      } result_t;
+
+      TrackEncoder(uint8_t *frame, size_t size, uint32_t tolerance = 500, uint32_t maxGap = 60, uint8_t precision = 1);
+
+      result_t add(int32_t latitude, int32_t longitude, uint32_t time);
+      result_t add(const ME310::gnss_fix_t &fix);
+      size_t finish();
+      void reset();
+      void restart();
+
+      bool full() const;
+      const uint8_t *frame() const { return _frame; }   //!< Returns the frame
+      size_t length() const { return _len; }             //!< Returns the frame length in bytes
+      uint8_t count() const { return _frame[2]; }        //!< Returns the number of points of the frame
+      uint32_t fixes() const { return _fixes; }          //!< Returns the number of fixes added since the construction
+      uint32_t kept() const { return _kept; }            //!< Returns the number of points written since the construction
+      uint32_t bytes() const { return _bytes + _len; }   //!< Returns the bytes of the frames written since the construction
+
+      static uint32_t unix_time(const ME310::gnss_fix_t &fix);
+
+      private:
+
+      /*! \struct point_t
+         \brief Fix as given to add()
+      */
+      typedef struct
+      {
+         int32_t latitude;       ///< Latitude, in 1e-7 degrees
+         int32_t longitude;      ///< Longitude, in 1e-7 degrees
+         uint32_t time;          ///< Time, in seconds
+      } point_t;
+
+      bool outside(const point_t &point) const;
+      void keep(const point_t &point);
+      void write(uint32_t value);
+      int32_t quantize(int32_t value) const;
+
+      uint8_t *_frame;           //!< Frame buffer
+      size_t _size;              //!< Size of the frame buffer
+      size_t _len;               //!< Bytes written in the frame
+      uint32_t _tolerance;       //!< Dead band, in cm
+      uint32_t _maxGap;          //!< Max time between kept points, in seconds
+      uint8_t _precision;        //!< Decimal digits removed from the coordinates
+      int32_t _divisor;          //!< 10^_precision
+      point_t _last;             //!< Last kept point
+      point_t _prev;             //!< Point kept before _last
+      point_t _candidate;        //!< Last dropped fix
+      uint8_t _points;           //!< Points kept since the construction or restart(), up to 2
+      bool _hasCandidate;        //!< _candidate is valid
+      int32_t _encLatitude;      //!< Quantized latitude of the last point written in the frame
+      int32_t _encLongitude;     //!< Quantized longitude of the last point written in the frame
+      uint32_t _encTime;         //!< Time of the last point written in the frame
+      uint32_t _fixes;           //!< Fixes added
+      uint32_t _kept;            //!< Points written
+      uint32_t _bytes;           //!< Bytes of the frames reset
+   };
+} // end namespace
+
+#endif //__TRACKENCODER__H